@@ -8,6 +8,8 @@
 
 #include <cstdint>
 
+#include "m8common/options/Options.hpp"
+
 #include "m8chess/Analyzer.hpp"
 #include "m8chess/Types.hpp"
 
@@ -40,7 +42,9 @@ namespace m8::commands
                 ("depth", po::value<DepthType>(&depth_)->default_value(std::numeric_limits<DepthType>::max()),
                     "Maximum depth of the analysis")
                 ("time",  po::value<float>(&time_)->default_value(std::numeric_limits<float>::infinity()),
-                    "Time to analyze the position");
+                    "Time to analyze the position")
+                ("threads", po::value<std::uint32_t>(&options::Options::get().threads),
+                    "Number of threads used by the search");
 
             return command_options;
         }
@@ -6,9 +6,13 @@
 #ifndef M8_COMMANDS_BENCH_COMMAND_HPP_
 #define M8_COMMANDS_BENCH_COMMAND_HPP_
 
+#include <chrono>
+#include <optional>
 #include <thread>
 
+#include "m8common/options/Options.hpp"
 #include "m8common/Output.hpp"
+#include "m8common/stringHelpers.hpp"
 
 #include "m8chess/Benchmark.hpp"
 
@@ -22,13 +26,36 @@ namespace m8::commands
     public:
         BenchCommand()
         : deltaDepth_(0),
-          threads_(0)
+          threads_(0),
+          signature_(false)
         {}
 
         void operator()()
         {
-            Benchmark bench(deltaDepth_, runs_, threads_);
-            bench.Run();
+            Benchmark bench(deltaDepth_,
+                            signature_ ? 1 : runs_,
+                            signature_ ? 1 : threads_,
+                            json_file_,
+                            baseline_file_);
+
+            if (!epd_file_.empty())
+            {
+                bench.LoadEpd(epd_file_);
+            }
+            bench.SetLimits(depth_, nodes_, move_time_);
+
+            if (!scaling_.empty())
+            {
+                bench.RunScaling(ParseThreadCounts(scaling_));
+            }
+            else if (signature_)
+            {
+                bench.RunSignature();
+            }
+            else
+            {
+                bench.Run();
+            }
         };
 
         /// Returns the descriptions of the command line options supported for this command
@@ -40,9 +67,18 @@ namespace m8::commands
 
             po::options_description command_options("Bench Options");
             command_options.add_options()
-                ("delta-depth", po::value<std::int16_t>(&deltaDepth_), "Depth to add or remove from the default depth of each position.")
-                ("threads",     po::value<std::uint32_t>(&threads_)->default_value(num_cpus), "Number of parallele threads to use for the benchmark.")
-                ("runs",        po::value<std::uint32_t>(&runs_)->default_value(num_cpus), "Number of times all the position are searched. The result will be the means of the runs after the fastest and slowest runs are removed.");
+                ("delta-depth",    po::value<std::int16_t>(&deltaDepth_), "Depth to add or remove from the default depth of each position.")
+                ("threads",        po::value<std::uint32_t>(&threads_)->default_value(num_cpus), "Number of parallele threads to use for the benchmark.")
+                ("search-threads", po::value<std::uint32_t>(&options::Options::get().threads)->default_value(1), "Number of threads used by each search (Lazy SMP). Use with --threads 1 to measure the time to depth scaling of the parallel search.")
+                ("runs",           po::value<std::uint32_t>(&runs_)->default_value(num_cpus), "Number of times all the position are searched. The result will be the means of the runs after the fastest and slowest runs are removed.")
+                ("epd",            po::value<std::string>(&epd_file_), "EPD file containing the positions to search instead of the default positions. A limit (depth, nodes or movetime) is required.")
+                ("depth",          po::value<DepthType>()->notifier([this](DepthType depth) { depth_ = depth; }), "Depth of the search of all the positions.")
+                ("nodes",          po::value<NodeCounterType>()->notifier([this](NodeCounterType nodes) { nodes_ = nodes; }), "Minimum number of nodes searched in each position. The search stops at the end of the iteration.")
+                ("movetime",       po::value<std::uint32_t>()->notifier([this](std::uint32_t ms) { move_time_ = std::chrono::milliseconds(ms); }), "Time allowed for each position in milliseconds.")
+                ("json",           po::value<std::string>(&json_file_), "Name of a file where the results are saved in json.")
+                ("signature",      po::bool_switch(&signature_), "Search all the positions once with a single thread and a fixed transposition table size and print the number of nodes searched. The number changes only if the behavior of the search changes.")
+                ("scaling",        po::value<std::string>(&scaling_), "Run the benchmark with each number of search threads of a comma separated list (e.g. 1,2,4,8) and report the speedups. A single thread is always tested first. The runs are executed one at a time.")
+                ("baseline",       po::value<std::string>(&baseline_file_), "Name of a json file saved by a previous benchmark. Report if the nodes per second are significantly different.");
             return command_options;
         }
         
@@ -50,6 +86,14 @@ namespace m8::commands
         std::int16_t deltaDepth_;
         std::uint32_t threads_;
         std::uint32_t runs_;
+        std::string json_file_;
+        std::string baseline_file_;
+        bool signature_;
+        std::string epd_file_;
+        std::optional<DepthType> depth_;
+        std::optional<NodeCounterType> nodes_;
+        std::optional<std::chrono::milliseconds> move_time_;
+        std::string scaling_;
     };
 }
 
@@ -21,6 +21,9 @@ namespace m8::commands
 
         /// Returns the descriptions of the command line options supported for this command
         virtual boost::program_options::options_description GetOptionsDescriptions() = 0;
+
+        /// Returns the exit code of the application after the command is executed.
+        virtual int exit_code() const { return 0; }
     };
 }
 
@@ -13,6 +13,7 @@
 #include "BenchCommand.hpp"
 #include "Command.hpp"
 #include "PerftCommand.hpp"
+#include "PerftSuiteCommand.hpp"
 #include "UCICommand.hpp"
 
 namespace m8::commands
@@ -44,6 +45,11 @@ namespace m8::commands
             return std::make_unique<PerftCommand>();
         }
 
+        if (command_name == "perft-suite")
+        {
+            return std::make_unique<PerftSuiteCommand>();
+        }
+
         return nullptr;
     }
 }
@@ -6,13 +6,21 @@
 #ifndef M8_COMMANDS_PERFT_COMMAND_HPP_
 #define M8_COMMANDS_PERFT_COMMAND_HPP_
 
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <vector>
 
 #include "m8common/Output.hpp"
+#include "m8common/stringHelpers.hpp"
 #include "m8common/Utils.hpp"
 
 #include "m8chess/Board.hpp"
 #include "m8chess/Perft.hpp"
+#include "m8chess/PerftWorkUnit.hpp"
 #include "Command.hpp"
 
 namespace m8::commands
@@ -23,8 +31,37 @@ namespace m8::commands
     public:
         void operator()()
         {
+            if (!merge_.empty())
+            {
+                PerftWorkUnit::Merge(merge_, *this);
+                return;
+            }
+
+            if (!work_.empty())
+            {
+                RunWorkUnit();
+                return;
+            }
+
+            if (depth_ == 0)
+            {
+                throw boost::program_options::required_option("depth");
+            }
+
+            if (0 < split_)
+            {
+                SplitWorkUnits();
+                return;
+            }
+
+            if (!scaling_.empty())
+            {
+                RunScaling();
+                return;
+            }
+
             Board board(fen_);
-            m8::Perft perft(depth_, board, this);
+            m8::Perft perft(depth_, board, this, checkpoint_);
             perft.Run();
         };
 
@@ -35,9 +72,16 @@ namespace m8::commands
 
             po::options_description command_options("Perft Options");
             command_options.add_options()
-                ("depth",   po::value<std::uint32_t>(&depth_)->required(), "Depth of the perft test (required)")
+                ("depth",   po::value<std::uint32_t>(&depth_), "Depth of the perft test (required, except with --work and --merge)")
                 ("fen",     po::value<std::string>(&fen_)->default_value(kStartingPositionFEN), "FEN string representing the position to use for the perft test")
-                ("threads", po::value<std::int32_t>(&options::Options::get().perft_threads), "Number of parallele threads to use for the perft test");
+                ("threads", po::value<std::int32_t>(&options::Options::get().perft_threads), "Number of parallele threads to use for the perft test")
+                ("hash",    po::value<std::uint32_t>(&options::Options::get().perft_hash), "Size of the perft hash table in megabytes (0 to disable)")
+                ("checkpoint", po::value<std::string>(&checkpoint_), "File used to save the progress of the perft test. If the file exists, the test is resumed from it")
+                ("split",   po::value<std::uint32_t>(&split_), "Split the perft test into this number of work units, written in the --out directory")
+                ("out",     po::value<std::string>(&out_), "Directory where the work units are written")
+                ("work",    po::value<std::string>(&work_), "Count a work unit file. The result is written next to the work unit")
+                ("merge",   po::value<std::string>(&merge_), "Sum the results of the work units in a directory")
+                ("scaling", po::value<std::string>(&scaling_), "Run the test with each number of threads of a comma separated list (e.g. 1,2,4,8) and report the speedups. A single thread is always tested first.");
             return command_options;
         }
 
@@ -60,14 +104,91 @@ namespace m8::commands
             Output out;
             out << '\n'
                 << "Threads: " <<options::Options::get().perft_threads <<'\n'
+                << "Hash: " << options::Options::get().perft_hash << " MB" << '\n'
                 << "Nodes: " << count << '\n'
                 << "Time: " << time << '\n'
                 << "Nodes per second: " << AddMetricSuffix(static_cast<std::uint64_t>(count / time), 3) << std::endl;
         }
         
     private:
-        std::uint32_t depth_;
+        std::uint32_t depth_ = 0;
         std::string fen_;
+        std::string checkpoint_;
+        std::uint32_t split_ = 0;
+        std::string out_;
+        std::string work_;
+        std::string merge_;
+        std::string scaling_;
+
+        void SplitWorkUnits()
+        {
+            if (out_.empty())
+            {
+                throw boost::program_options::required_option("out");
+            }
+
+            Board board(fen_);
+            auto units = PerftWorkUnit::Split(board, depth_, split_);
+
+            std::filesystem::create_directories(out_);
+            for (std::size_t i = 0; i < units.size(); ++i)
+            {
+                std::ostringstream filename;
+                filename << "unit-" << std::setw(4) << std::setfill('0') << i + 1 << ".unit";
+                units[i].Write((std::filesystem::path(out_) / filename.str()).string());
+            }
+
+            Output out;
+            out << units.size() << " work units written to " << out_ << std::endl;
+        }
+
+        void RunScaling()
+        {
+            auto thread_counts = ParseThreadCounts(scaling_);
+
+            Board board(fen_);
+            Output out;
+            out << "Threads\tTime\tNodes per second\tSpeedup\tEfficiency\tIdle" << '\n';
+
+            double base_nps = 0;
+            for (auto threads : thread_counts)
+            {
+                // Each test has its own hash table so they all start with an empty one.
+                PerftCountObserver observer;
+                PerftHashTable hash_table(static_cast<std::size_t>(options::Options::get().perft_hash) * 1024 * 1024);
+                Perft perft(depth_, board, &observer, hash_table, threads);
+                perft.Run();
+
+                auto nps = observer.count() / observer.time();
+                if (base_nps == 0)
+                {
+                    base_nps = nps;
+                }
+
+                // The idle time is reported as a fraction of the time available to all
+                // the threads.
+                auto idle = std::chrono::duration<double>(perft.idle_time()).count() / (observer.time() * threads);
+                auto speedup = nps / base_nps;
+                out << threads << '\t'
+                    << std::fixed << std::setprecision(3) << observer.time() << '\t'
+                    << AddMetricSuffix(static_cast<std::uint64_t>(nps), 3) << '\t'
+                    << std::setprecision(2) << speedup << '\t'
+                    << std::setprecision(1) << speedup / threads * 100 << "%\t"
+                    << idle * 100 << "%" << std::endl;
+            }
+        }
+
+        void RunWorkUnit()
+        {
+            auto unit = PerftWorkUnit::Read(work_);
+
+            auto start = std::chrono::steady_clock::now();
+            auto counts = unit.Run();
+            auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            unit.WriteResult(std::filesystem::path(work_).replace_extension(".result").string(), counts, time);
+            OnPerftCompleted(std::accumulate(counts.begin(), counts.end(), UINT64_C(0)), time);
+        }
     };
 }
 
@@ -0,0 +1,58 @@
+/// @file PerftSuiteCommand.hpp
+/// @author Mathieu Pagé
+/// @date October 2026
+/// @brief Contains the PerftSuiteCommand class
+
+#ifndef M8_COMMANDS_PERFT_SUITE_COMMAND_HPP_
+#define M8_COMMANDS_PERFT_SUITE_COMMAND_HPP_
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "m8chess/PerftSuite.hpp"
+
+#include "Command.hpp"
+
+namespace m8::commands
+{
+    /// Implements the perft-suite command that checks the node counts of all the
+    /// positions of an EPD perft file.
+    class PerftSuiteCommand : public Command
+    {
+    public:
+        void operator()()
+        {
+            PerftSuite suite(file_, max_depth_, threads_, hash_);
+            success_ = suite.Run();
+        };
+
+        /// Returns the descriptions of the command line options supported for this command
+        boost::program_options::options_description GetOptionsDescriptions()
+        {
+            namespace po = boost::program_options;
+
+            unsigned int num_cpus = std::thread::hardware_concurrency();
+
+            po::options_description command_options("Perft Suite Options");
+            command_options.add_options()
+                ("file",      po::value<std::string>(&file_)->required(), "EPD file containing the positions and the expected node counts (required)")
+                ("max-depth", po::value<int>(&max_depth_)->default_value(6), "Maximum depth tested. The deeper counts of the file are skipped")
+                ("threads",   po::value<std::uint32_t>(&threads_)->default_value(num_cpus), "Number of perft tests run in parallel")
+                ("hash",      po::value<std::uint32_t>(&hash_)->default_value(0), "Size of the perft hash table shared by all the tests in megabytes (0 to disable)");
+            return command_options;
+        }
+
+        /// Returns a non-zero exit code if a node count is wrong.
+        int exit_code() const { return success_ ? 0 : 1; }
+
+    private:
+        std::string file_;
+        int max_depth_;
+        std::uint32_t threads_;
+        std::uint32_t hash_;
+        bool success_ = false;
+    };
+}
+
+#endif // M8_COMMANDS_PERFT_SUITE_COMMAND_HPP_
@@ -24,7 +24,8 @@ namespace m8
     {
         // If there is no commands, we return uci, the default command.
         if (   argc < 2
-            || !std::all_of(argv[1], argv[1] + std::strlen(argv[1]), [](char c) { return std::isalpha(c); }))
+            || !std::isalpha(argv[1][0])
+            || !std::all_of(argv[1], argv[1] + std::strlen(argv[1]), [](char c) { return std::isalpha(c) || c == '-'; }))
         {
             return { commands::CreateCommand("uci"), argc, argv };
         }
@@ -44,10 +45,11 @@ namespace m8
         out << "usage : m8 [command] [options]\n"
             << '\n'
             << "Allowed commands\n"
-            << "  uci     Launch m8 in UCI mode (this is the default command).\n"
-            << "  analyze Analyze a chess position.\n"
-            << "  perft   Run a perft test, counting the nodes reachables from a position at a given depth.\n"
-            << "  bench   Run a benchmark."
+            << "  uci         Launch m8 in UCI mode (this is the default command).\n"
+            << "  analyze     Analyze a chess position.\n"
+            << "  perft       Run a perft test, counting the nodes reachables from a position at a given depth.\n"
+            << "  perft-suite Check the node counts of all the positions of an EPD perft file.\n"
+            << "  bench       Run a benchmark."
             << '\n'
             << "The command is optional. If a command is not provided, m8 execute in UCI mode.\n";
 
@@ -96,6 +98,7 @@ int main(int argc, char* argv[])
 
         m8::InitializePreCalc();
         (*command)();
+        return command->exit_code();
     }
     catch (const po::required_option& ex)
     {
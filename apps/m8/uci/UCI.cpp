@@ -19,13 +19,14 @@ namespace m8::uci
 {
     const std::unordered_map<std::string, std::function<void(UCI*, const std::vector<std::string>&)>> UCI::HANDLERS =
     {
-        {"uci",       &UCI::HandleUci},
-        {"isready",   &UCI::HandleIsready},
-        {"position",  &UCI::HandlePosition},
-        {"go",        &UCI::HandleGo},
-        {"stop",      &UCI::HandleStop},
-        {"quit",      &UCI::HandleQuit},
-        {"setoption", &UCI::HandleSetOption}
+        {"uci",        &UCI::HandleUci},
+        {"isready",    &UCI::HandleIsready},
+        {"ucinewgame", &UCI::HandleUCINewGame},
+        {"position",   &UCI::HandlePosition},
+        {"go",         &UCI::HandleGo},
+        {"stop",       &UCI::HandleStop},
+        {"quit",       &UCI::HandleQuit},
+        {"setoption",  &UCI::HandleSetOption}
     };
 
     void UCI::Run()
@@ -67,6 +68,11 @@ namespace m8::uci
         engine_.HandleIsready();
     }
 
+    void UCI::HandleUCINewGame(const std::vector<std::string> params)
+    {
+        engine_.HandleUCINewGame();
+    }
+
     void UCI::HandlePosition(const std::vector<std::string> params)
     {
         const std::string startpos = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
@@ -25,6 +25,7 @@ namespace m8::uci
     private:
         void HandleUci(const std::vector<std::string> params);
         void HandleIsready(const std::vector<std::string> params);
+        void HandleUCINewGame(const std::vector<std::string> params);
         void HandlePosition(const std::vector<std::string> params);
         void HandleGo(const std::vector<std::string> params);
         void HandleStop(const std::vector<std::string> params);
@@ -5,6 +5,7 @@
 
 #include <chrono>
 #include <exception>
+#include <new>
 #include <stack>
 
 #include "m8common/options/Options.hpp"
@@ -18,10 +19,14 @@ namespace m8::uci
 {
     UCIEngine::UCIEngine()
     : board_(kStartingPositionFEN),
-      transposition_table_(options::Options::get().tt_size*1024*1024),
+      transposition_table_(kInitialTranspositionTableSize),
       searcher_(transposition_table_)
     {
         searcher_.Attach(this);
+
+        // The table is allocated at its configured size in the background so the engine
+        // can answer the gui right away.
+        ResizeTranspositionTable();
     }
 
     void UCIEngine::HandleUCI()
@@ -29,12 +34,25 @@ namespace m8::uci
         interface_.SendId("name", "m8");
         interface_.SendId("author", "Mathieu Pagé <m@mathieupage.com>");
         interface_.SendSpinOption("Hash", 1, 1024*1024, options::Options::get().tt_size);
+        interface_.SendSpinOption("Threads", 1, 1024, options::Options::get().threads);
+        interface_.SendSpinOption("LmrBase", -500, 500, options::Options::get().lmr_base);
+        interface_.SendSpinOption("LmrDivisor", 50, 1000, options::Options::get().lmr_divisor);
+        interface_.SendSpinOption("LmrMinDepth", 1, 20, options::Options::get().lmr_min_depth);
+        interface_.SendSpinOption("LmrFullDepthMoves", 1, 64, options::Options::get().lmr_full_depth_moves);
+        interface_.SendSpinOption("LmrHistoryDivisor", 1, 16384, options::Options::get().lmr_history_divisor);
         interface_.SendCheckOption("UCI_Chess960", false);
         interface_.SendUciok();
     }
 
     void UCIEngine::HandleIsready()
     {
+        // We don't wait for the transposition table to be ready, the search will. This
+        // way the gui don't time out while a large table is allocated.
+        if (IsTranspositionTableReady())
+        {
+            SendTranspositionTableInfo();
+        }
+
         interface_.SendReadyok();
     }
 
@@ -68,6 +86,8 @@ namespace m8::uci
         auto time_manager = std::make_unique<TimeManager>(time, inc, moves_to_go, move_time, infinite);
 
         auto search = std::make_shared<search::Search>(board_, std::move(time_manager), 100);
+        WaitForTranspositionTable();
+        SendTranspositionTableInfo();
         searcher_.Start(search);
     }
 
@@ -88,7 +108,130 @@ namespace m8::uci
 
         // We resize the transposition table here in case it was resize by the option
         // command. This will have no effect if the size remains the same.
-        transposition_table_.Resize(options::Options::get().tt_size * 1024 * 1024);
+        ResizeTranspositionTable();
+    }
+
+    void UCIEngine::HandleUCINewGame()
+    {
+        std::lock_guard lock(transposition_table_mutex_);
+        transposition_table_clear_pending_ = true;
+        StartTranspositionTableTask();
+    }
+
+    void UCIEngine::ResizeTranspositionTable()
+    {
+        std::lock_guard lock(transposition_table_mutex_);
+        transposition_table_target_size_ = static_cast<std::size_t>(options::Options::get().tt_size) * 1024 * 1024;
+        StartTranspositionTableTask();
+    }
+
+    void UCIEngine::StartTranspositionTableTask()
+    {
+        // A running task picks up the new requests before it completes, so the gui
+        // never waits for it.
+        bool has_work = transposition_table_clear_pending_
+                     || transposition_table_target_size_ != transposition_table_size_;
+        if (transposition_table_task_running_ || !has_work)
+        {
+            return;
+        }
+
+        transposition_table_task_running_ = true;
+        transposition_table_task_ = std::async(std::launch::async, [this]() { RunTranspositionTableTask(); });
+    }
+
+    void UCIEngine::RunTranspositionTableTask()
+    {
+        std::unique_lock lock(transposition_table_mutex_);
+        while (true)
+        {
+            auto size = transposition_table_target_size_;
+            bool resize = size != transposition_table_size_;
+            bool clear = transposition_table_clear_pending_;
+            if (!resize && !clear)
+            {
+                transposition_table_task_running_ = false;
+                return;
+            }
+
+            transposition_table_size_ = size;
+            transposition_table_clear_pending_ = false;
+            lock.unlock();
+
+            auto previous_size = transposition_table_.size();
+            bool allocation_failed = false;
+            if (resize)
+            {
+                try
+                {
+                    transposition_table_.Resize(size);
+                }
+                catch (const std::bad_alloc&)
+                {
+                    // The table keeps its previous size.
+                    allocation_failed = true;
+                }
+            }
+
+            // The table is already empty if its size changed.
+            if (clear && previous_size == transposition_table_.size())
+            {
+                transposition_table_.Empty();
+            }
+
+            lock.lock();
+            if (resize)
+            {
+                transposition_table_allocation_failed_ = allocation_failed;
+                transposition_table_info_pending_ |= allocation_failed || previous_size != transposition_table_.size();
+            }
+        }
+    }
+
+    bool UCIEngine::IsTranspositionTableReady() const
+    {
+        std::lock_guard lock(transposition_table_mutex_);
+        return !transposition_table_task_running_;
+    }
+
+    void UCIEngine::WaitForTranspositionTable()
+    {
+        if (transposition_table_task_.valid())
+        {
+            transposition_table_task_.get();
+        }
+    }
+
+    void UCIEngine::SendTranspositionTableInfo()
+    {
+        std::lock_guard lock(transposition_table_mutex_);
+        if (!transposition_table_info_pending_)
+        {
+            return;
+        }
+        transposition_table_info_pending_ = false;
+
+        auto info = "Transposition table " + std::to_string(transposition_table_.size() / (1024 * 1024))
+                  + " MB, " + std::string(ToString(transposition_table_.page_mode()));
+        if (transposition_table_allocation_failed_)
+        {
+            info += ", unable to allocate " + std::to_string(options::Options::get().tt_size) + " MB";
+        }
+
+        interface_.SendInfo(std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            std::nullopt,
+                            info);
     }
 
     void UCIEngine::OnNewBestMove(const search::PV& pv, EvalType eval, DepthType depth, double time, NodeCounterType nodes)
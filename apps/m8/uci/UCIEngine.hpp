@@ -6,6 +6,9 @@
 #ifndef M8_UCI_UCI_ENGINE_HPP_
 #define M8_UCI_UCI_ENGINE_HPP_
 
+#include <future>
+#include <mutex>
+
 #include "m8chess/Board.hpp"
 #include "m8chess/search/PV.hpp"
 #include "m8chess/search/Searcher.hpp"
@@ -66,6 +69,9 @@ namespace m8::uci
         void HandleSetOption(std::string_view name,
                              std::optional<std::string_view> value);
 
+        /// Handles the ucinewgame command from the uci protocol
+        void HandleUCINewGame();
+
         /// Method called when a new best move is found at the root.
         void OnNewBestMove(const search::PV& pv, EvalType eval, DepthType depth, double time, NodeCounterType nodes);
 
@@ -83,7 +89,59 @@ namespace m8::uci
         transposition::TranspositionTable transposition_table_;
         search::Searcher searcher_;
 
+        /// Size of the transposition table until it is allocated at its configured size.
+        static const std::size_t kInitialTranspositionTableSize = 1024 * 1024;
+
+        /// Protects the state shared with the transposition table task.
+        mutable std::mutex transposition_table_mutex_;
+
+        /// True while the transposition table task is running.
+        bool transposition_table_task_running_ = false;
+
+        /// Size of the transposition table requested by the options, in bytes.
+        std::size_t transposition_table_target_size_ = kInitialTranspositionTableSize;
+
+        /// Size the transposition table task last resized the table to, in bytes.
+        std::size_t transposition_table_size_ = kInitialTranspositionTableSize;
+
+        /// True if the transposition table must be cleared.
+        bool transposition_table_clear_pending_ = false;
+
+        bool transposition_table_info_pending_ = true;
+
+        /// True if the transposition table could not be allocated at its configured
+        /// size and kept its previous size.
+        bool transposition_table_allocation_failed_ = false;
+
+        /// Resize and clear of the transposition table running in the background. It is
+        /// declared after the state it shares so it is destroyed, and waited for, first.
+        std::future<void> transposition_table_task_;
+
         std::vector<std::string> RenderPVMoves(const search::PV& pv);
+
+        /// Resize the transposition table to its configured size in the background.
+        void ResizeTranspositionTable();
+
+        /// Start the transposition table task if there is a resize or a clear to do and
+        /// it is not already running. Must be called with transposition_table_mutex_
+        /// locked.
+        void StartTranspositionTableTask();
+
+        /// Resize and clear the transposition table until all the requests made while
+        /// it runs are done.
+        void RunTranspositionTableTask();
+
+        /// Returns true if the transposition table is not resized or cleared.
+        bool IsTranspositionTableReady() const;
+
+        /// Wait for the resize or clear of the transposition table to complete. The
+        /// table must not be accessed before this is called.
+        void WaitForTranspositionTable();
+
+        /// Send the size of the transposition table and the type of pages backing it in
+        /// an info string, to check the configuration of the host. Nothing is sent if the
+        /// table did not change since the last time.
+        void SendTranspositionTableInfo();
     };
 }
 
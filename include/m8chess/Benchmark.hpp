@@ -6,9 +6,18 @@
 #ifndef M8_BENCHMARK_HPP_
 #define M8_BENCHMARK_HPP_
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include "m8common/LargePages.hpp"
+#include "m8common/Output.hpp"
+#include "m8common/Statistics.hpp"
 
 #include "m8chess/search/Searcher.hpp"
 
@@ -17,6 +26,16 @@
 
 namespace m8
 {
+    /// Exception thrown when the positions of a benchmark can't be loaded.
+    class BenchmarkError : public std::runtime_error
+    {
+    public:
+        /// Constructor
+        BenchmarkError(const std::string& what_arg)
+            : std::runtime_error(what_arg)
+        {};
+    };
+
     class Benchmark
     {
     public:
@@ -26,26 +45,89 @@ namespace m8
         ///                   position searched in the benchmark.
         /// @param runs Number of times each positions is runned.
         /// @param threads_count Number of runs that can be executed in parrallel.
-        Benchmark(DepthType deltaDepth, std::uint32_t runs, std::uint32_t threads_count);
+        /// @param json_file Name of the file where the results are saved in json. No file is
+        ///                  written if empty.
+        /// @param baseline_file Name of a json file written by a previous benchmark. The
+        ///                      results are compared to it if not empty.
+        Benchmark(DepthType deltaDepth,
+                  std::uint32_t runs,
+                  std::uint32_t threads_count,
+                  const std::string& json_file = "",
+                  const std::string& baseline_file = "");
+
+        /// Replace the positions of the benchmark by the positions of an EPD file. Only the
+        /// first four fields of each line are used, the operations are ignored.
+        ///
+        /// The positions of an EPD file have no default depth, a limit must be set with
+        /// SetLimits.
+        void LoadEpd(const std::string& filename);
+
+        /// Set the limits of the searches. Each limit that is set replaces the default
+        /// depth of the positions.
+        ///
+        /// @param depth     Depth of all the searches.
+        /// @param nodes     Minimum number of nodes searched in each position. The search
+        ///                  stops at the end of the first iteration that reached it.
+        /// @param move_time Time allowed for each position.
+        void SetLimits(std::optional<DepthType> depth,
+                       std::optional<NodeCounterType> nodes,
+                       std::optional<std::chrono::milliseconds> move_time);
 
         /// Run the benchmark.
         void Run();
+
+        /// Search all the positions once, with a single thread and a transposition table
+        /// of fixed size, and print the total number of nodes searched. This number only
+        /// changes when the behavior of the search changes.
+        void RunSignature();
+
+        /// Run the benchmark with each number of search threads and report the nodes per
+        /// second, the speedup and the efficiency of the parallel search. The runs are
+        /// executed one at a time.
+        ///
+        /// @param search_threads Numbers of search threads to test. The speedups are
+        ///                       relative to the first one, usually a single thread (see
+        ///                       ParseThreadCounts).
+        void RunScaling(const std::vector<std::uint32_t>& search_threads);
+
+        /// Size of the transposition table used for the signature, in bytes.
+        static constexpr std::size_t kSignatureTTSize = 16 * 1024 * 1024;
         
     private:
         DepthType deltaDepth_;
         std::uint32_t runs_;
         std::uint32_t threads_count_;
-        std::vector<BenchmarkResult> results_;
+        std::string json_file_;
+        std::string baseline_file_;
+        std::size_t tt_size_;
+
+        /// Type of pages backing the transposition tables of the searches.
+        std::atomic<PageMode> tt_page_mode_ = PageMode::Normal;
+
+        std::optional<DepthType> depth_;
+        std::optional<NodeCounterType> nodes_;
+        std::optional<std::chrono::milliseconds> move_time_;
+
+        /// Positions searched and their default depth.
+        std::vector<std::pair<std::string, DepthType>> positions_;
+
+        /// Results of each run, with the result of each position.
+        std::vector<std::vector<BenchmarkResult>> results_;
 
         std::vector<std::thread> threads_;
         std::mutex mutex_;
         bool abort_;
 
-        static std::array<std::pair<std::string, DepthType>, 64> positions;
+        static std::array<std::pair<std::string, DepthType>, 64> default_positions;
 
         BenchmarkResult RunPosition(std::string_view fen, DepthType depth);
-        BenchmarkResult RunBenchmark();
+        std::vector<BenchmarkResult> RunBenchmark();
         void RunBenchmarks();
+
+        void ValidateLimits() const;
+        void PrintPhases(Output& out, const std::vector<BenchmarkResult>& position_results) const;
+        void WriteJson(const SampleStatistics& nps, const SampleStatistics& time) const;
+        void CompareToBaseline(const std::vector<double>& nps_samples, NodeCounterType nodes) const;
     };
 }
 
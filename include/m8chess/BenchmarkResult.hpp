@@ -6,6 +6,8 @@
 #ifndef M8_BENCHMARK_RESULT_HPP_
 #define M8_BENCHMARK_RESULT_HPP_
 
+#include <algorithm>
+
 #include "m8common/chronoHelpers.hpp"
 #include "m8common/Timer.hpp"
 
@@ -21,10 +23,19 @@ namespace m8
         /// 
         /// @param duration duration of the test.
         /// @param nodes    Number of nodes searched in the test.
+        /// @param depth    Depth of the last iteration completed.
+        /// @param tt_probes Number of transposition table probes.
+        /// @param tt_hits   Number of transposition table probes that found the position.
         inline BenchmarkResult(Timer::ClockType::duration duration = std::chrono::seconds(0),
-                               NodeCounterType nodes = 0)
+                               NodeCounterType nodes = 0,
+                               DepthType depth = 0,
+                               std::uint64_t tt_probes = 0,
+                               std::uint64_t tt_hits = 0)
         : duration_(duration),
-          nodes_(nodes)
+          nodes_(nodes),
+          depth_(depth),
+          tt_probes_(tt_probes),
+          tt_hits_(tt_hits)
         {}
 
         /// Returns the duration of the test
@@ -33,25 +44,42 @@ namespace m8
         /// Returns the number of nodes searched durint the test
         inline NodeCounterType nodes() const { return nodes_; }
 
+        /// Returns the depth of the last iteration completed. When results are added, this
+        /// is the deepest of the results.
+        inline DepthType depth() const { return depth_; }
+
         /// Returns the nodes per seconds for the test.
         inline NodeCounterType nps() const { return nodes_ / ToFSec(duration_).count(); }
 
+        /// Returns the proportion of the transposition table probes that found the
+        /// position.
+        inline double tt_hit_rate() const { return tt_probes_ ? static_cast<double>(tt_hits_) / tt_probes_ : 0; }
+
         inline BenchmarkResult& operator+=(const BenchmarkResult rhs)
         {
             this->duration_ += rhs.duration_;
             this->nodes_    += rhs.nodes_;
+            this->depth_     = std::max(this->depth_, rhs.depth_);
+            this->tt_probes_ += rhs.tt_probes_;
+            this->tt_hits_   += rhs.tt_hits_;
             return *this;
         }
 
         inline BenchmarkResult operator+(const BenchmarkResult rhs)
         {
             return BenchmarkResult(this->duration_ + rhs.duration_,
-                                   this->nodes_    + rhs.nodes_);
+                                   this->nodes_    + rhs.nodes_,
+                                   std::max(this->depth_, rhs.depth_),
+                                   this->tt_probes_ + rhs.tt_probes_,
+                                   this->tt_hits_   + rhs.tt_hits_);
         }
 
     private:
         Timer::ClockType::duration duration_;
         NodeCounterType nodes_;
+        DepthType depth_;
+        std::uint64_t tt_probes_;
+        std::uint64_t tt_hits_;
     };
 }
 
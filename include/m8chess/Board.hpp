@@ -194,6 +194,18 @@ namespace m8
         /// Value of the material on the board. Based on the piece-square table values.
         inline int material_value() const;
 
+        /// Estimate of the game phase based on the pieces on the board. It's
+        /// eval::kGamePhaseEstimateMax in the initial position and 0 when only the kings
+        /// and the pawns are left.
+        inline eval::GamePhaseEstimate game_phase_estimate() const { return game_phase_estimate_; }
+
+        /// Indicate if a color has any piece other than pawns and king on the board.
+        ///
+        /// @param color Color for which we want to know if there is non pawn material.
+        /// @returns True if there is at least one knight, bishop, rook or queen of the
+        ///          given color on the board.
+        inline bool has_non_pawn_material(Color color) const;
+
         /// Returns true if the position can be claimed as a draw because of a repetition 
         /// or the 50 move rule.
         ///
@@ -237,6 +249,29 @@ namespace m8
         ///                    was made.
         inline void Unmake(Move move, UnmakeInfo unmake_info);
 
+        /// Compute the hash key of the position after a move without making it. This
+        /// is used to prefetch the transposition table entry of the next position.
+        ///
+        /// @param move Move to evaluate.
+        /// @return The hash key that Make(move) would produce.
+        inline transposition::ZobristKey HashAfter(Move move) const;
+
+        /// Execute a null move on the board. The side to move is switched and the 
+        /// en passant column is cleared without moving any piece.
+        ///
+        /// The half move clock is reset because no position from before the null move
+        /// can be repeated after it.
+        ///
+        /// @return Info that need to be passed to UnmakeNull in order to unmake the 
+        ///         null move.
+        inline UnmakeInfo MakeNull();
+
+        /// Unmake a null move previously made on the board.
+        ///
+        /// @param unmake_info Informations used to unmake the null move produced when
+        ///                    it was made.
+        inline void UnmakeNull(UnmakeInfo unmake_info);
+
     private:
 
         /// Array containing the piece on each square of the board.
@@ -514,6 +549,12 @@ namespace m8
         return (material_middle_game_ * middle_game_fraction + material_end_game_ * end_game_fraction) / static_cast<int>(eval::kGamePhaseEstimateMax);
     }
 
+    inline bool Board::has_non_pawn_material(Color color) const
+    {
+        Bb pawns_and_king = bb_piece(NewPiece(kPawn, color)) | bb_piece(NewPiece(kKing, color));
+        return (bb_color(color) & ~pawns_and_king) != kEmptyBb;
+    }
+
     inline bool Board::is_draw() const
     {
         // If there has been more than 50 reversibles moves (100 half moves) the position is draw.
@@ -908,6 +949,120 @@ namespace m8
         // If the side to move is black decrement the move number.
         full_move_clock_ -= side_to_move_;
     }
+
+    inline transposition::ZobristKey Board::HashAfter(Move move) const
+    {
+        using transposition::gZobristTable;
+
+        Sq from = GetFrom(move);
+        Sq to = GetTo(move);
+        Piece piece = GetPiece(move);
+        Piece taken = GetPieceTaken(move);
+        PieceType piece_type = GetPieceType(piece);
+        Row first_row = GetColorWiseRow(side_to_move_, kRow1);
+
+        auto key = hash_key_ ^ transposition::gZobristBlackToMove;
+        if (IsColmnOnBoard(colmn_enpas_))
+        {
+            key ^= transposition::gZobristEnPassant[colmn_enpas_];
+        }
+
+        std::uint8_t casle_flag = casle_flag_;
+        CastleType castle = piece_type == kKing ? GetCastling(move) : 0;
+        if (castle != 0)
+        {
+            Piece rook = NewPiece(kRook, side_to_move_);
+            Sq rook_from = NewSq(casle_colmn_[castle - 1], first_row);
+            Sq rook_to = NewSq(castle == kKingSideCastle ? kF1 : kD1, first_row);
+            key ^= gZobristTable[piece][from] ^ gZobristTable[piece][to]
+                 ^ gZobristTable[rook][rook_from] ^ gZobristTable[rook][rook_to];
+        }
+        else
+        {
+            Piece promote_to = piece_type == kPawn ? GetPromoteTo(move) : kNoPiece;
+            key ^= gZobristTable[piece][from] ^ gZobristTable[IsPiece(promote_to) ? promote_to : piece][to];
+
+            if (taken != kNoPiece)
+            {
+                // If the piece taken is not on the target square it's a prise-en-passant.
+                Sq taken_sq = board_[to] == taken ? to : NewSq(GetColmn(to), GetRow(from));
+                key ^= gZobristTable[taken][taken_sq];
+            }
+
+            if (piece_type == kPawn && std::abs(to - from) == 16)
+            {
+                key ^= transposition::gZobristEnPassant[GetColmn(to)];
+            }
+        }
+
+        // Castling rights lost by moving the king or a rook or by capturing a rook.
+        if (piece_type == kKing)
+        {
+            casle_flag &= ~((kQueenSideCastle | kKingSideCastle) << side_to_move_ << side_to_move_);
+        }
+        else if (piece_type == kRook && GetRow(from) == first_row)
+        {
+            for (CastleType side : { kQueenSideCastle, kKingSideCastle })
+            {
+                if (GetColmn(from) == casle_colmn_[side - 1])
+                {
+                    casle_flag &= ~(side << side_to_move_ << side_to_move_);
+                }
+            }
+        }
+
+        if (IsPiece(taken) && GetPieceType(taken) == kRook)
+        {
+            Color color = GetColor(taken);
+            if (GetRow(to) == GetColorWiseRow(color, kRow1))
+            {
+                for (CastleType side : { kQueenSideCastle, kKingSideCastle })
+                {
+                    if (GetColmn(to) == casle_colmn_[side - 1])
+                    {
+                        casle_flag &= ~(side << color << color);
+                    }
+                }
+            }
+        }
+
+        if (casle_flag != casle_flag_)
+        {
+            key ^= transposition::gZobristCastling[casle_flag_] ^ transposition::gZobristCastling[casle_flag];
+        }
+
+        return key;
+    }
+
+    inline UnmakeInfo Board::MakeNull()
+    {
+        positions_history_.push_back(hash_key_);
+
+        UnmakeInfo unmake_info = colmn_enpas_ << 24 | casle_flag_ << 20 | half_move_clock_;
+
+        // If the side to move is black increment the move number
+        full_move_clock_ += side_to_move_;
+
+        half_move_clock_ = 0;
+        set_colmn_enpas(kInvalColmn);
+
+        SwitchSideToMove();
+
+        return unmake_info;
+    }
+
+    inline void Board::UnmakeNull(UnmakeInfo unmake_info)
+    {
+        positions_history_.pop_back();
+
+        half_move_clock_ = unmake_info & 0xFFFFF;
+        set_colmn_enpas(unmake_info >> 24);
+
+        SwitchSideToMove();
+
+        // If the side to move is black decrement the move number.
+        full_move_clock_ -= side_to_move_;
+    }
 }
 
 #endif // M8_BOARD_HPP_
\ No newline at end of file
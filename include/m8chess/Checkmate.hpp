@@ -33,26 +33,12 @@ namespace m8
     /// This method check if the side to move is mat. For performance reasons no 
     /// verification is made to make sure that the king is currently attacked (in check)
     /// this must be done separately.
-    inline bool IsMat(Board& board)
+    inline bool IsMat(const Board& board)
     {
-        Color side_to_move = board.side_to_move();
-
         MoveList moves;
-        movegen::GenerateAllMoves(board, moves);
-
-        // We look for a move that doesn't leave the side to move in check.
-        bool found = false;
-        auto next = moves.begin();
-        while (!found && next < moves.end())
-        {
-            UnmakeInfo unmake_info = board.Make(next->move);
-            found = !IsInCheck(side_to_move, board);
-            board.Unmake(next->move, unmake_info);
-
-            ++next;
-        }
+        movegen::GenerateLegalMoves(board, moves);
 
-        return !found;
+        return moves.size() == 0;
     }
 }
 
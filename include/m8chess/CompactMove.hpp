@@ -0,0 +1,122 @@
+/// @file CompactMove.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains a 16 bits encoding of the moves used to store them compactly.
+
+#ifndef M8_CHESS_COMPACT_MOVE_HPP_
+#define M8_CHESS_COMPACT_MOVE_HPP_
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+namespace m8
+{
+    /// Move encoded on 16 bits. It contains the origin, the destination, the castling
+    /// side and the type of the promotion. The pieces are found on the board when the
+    /// move is decoded.
+    typedef std::uint16_t CompactMove;
+
+    const CompactMove kNullCompactMove = 0;
+
+    /// The origin, the destination and the castling side are the least significant bits
+    /// of a Move.
+    const int kCompactMoveSquaresSize = kPiecePos;
+    const int kCompactPromotionPos    = kCompactMoveSquaresSize;
+
+    /// Types of the pieces a pawn can be promoted to, in the order they are encoded.
+    const std::array<PieceType, 4> kCompactPromotionTypes = { kKnight, kBishop, kRook, kQueen };
+
+    /// Encoding of the promotion of each piece type. This is the inverse of
+    /// kCompactPromotionTypes.
+    const std::array<std::uint32_t, 8> kCompactPromotionCodes = { 0, 0, 0, 0, 3, 1, 2, 0 };
+
+    /// Encode a move on 16 bits.
+    inline CompactMove ToCompactMove(Move move)
+    {
+        auto promotion = kCompactPromotionCodes[GetPieceType(GetPromoteTo(move))];
+        return static_cast<CompactMove>((move & ((1 << kCompactMoveSquaresSize) - 1))
+                                        | (promotion << kCompactPromotionPos));
+    }
+
+    /// Decode a move encoded on 16 bits in a position. The compact move can come from
+    /// another position (e.g. an hash collision), so it is rejected if it can't be a
+    /// move in this position. The move returned must still be checked with
+    /// IsPseudoLegal and IsLegal.
+    ///
+    /// @param compact_move Move to decode.
+    /// @param board        Position in which the move is played.
+    /// @return The move or kNullMove if it is not possible in the position.
+    inline Move FromCompactMove(CompactMove compact_move, const Board& board)
+    {
+        if (compact_move == kNullCompactMove)
+        {
+            return kNullMove;
+        }
+
+        Sq from = GetFrom(compact_move);
+        Sq to = GetTo(compact_move);
+        CastleType castling = GetCastling(compact_move);
+
+        Piece piece = board[from];
+        Color color = board.side_to_move();
+        if (!IsPiece(piece) || GetColor(piece) != color)
+        {
+            return kNullMove;
+        }
+
+        if (castling != kNoCastling)
+        {
+            // IsPseudoLegal doesn't verify the destination of the king, it must be the
+            // column C or G, as in Chess960.
+            bool valid = GetPieceType(piece) == kKing
+                      && castling <= kKingSideCastle
+                      && to == NewSq(castling == kQueenSideCastle ? kColmnC : kColmnG, GetRow(from));
+            return valid ? NewCastlingMove(from, to, piece, castling) : kNullMove;
+        }
+
+        Piece piece_taken = board[to];
+        if (IsPiece(piece_taken) && GetColor(piece_taken) == color)
+        {
+            return kNullMove;
+        }
+
+        if (GetPieceType(piece) != kPawn)
+        {
+            return NewMove(from, to, piece, piece_taken);
+        }
+
+        // The geometry of the pawn moves is not verified by IsPseudoLegal because the
+        // generated moves are always correct, so it is verified here.
+        int forward = GetColorWiseRow(color, GetRow(to)) - GetColorWiseRow(color, GetRow(from));
+        int sideway = std::abs(GetColmn(to) - GetColmn(from));
+        if (sideway == 1 && forward == 1)
+        {
+            // A diagonal move to an empty square can only be a prise en passant.
+            if (piece_taken == kNoPiece)
+            {
+                piece_taken = NewPiece(kPawn, OpposColor(color));
+            }
+        }
+        else if (sideway != 0
+                 || piece_taken != kNoPiece
+                 || (forward != 1 && (forward != 2 || GetColorWiseRow(color, GetRow(from)) != kRow2)))
+        {
+            return kNullMove;
+        }
+
+        Piece promote_to = kNoPiece;
+        if (GetColorWiseRow(color, GetRow(to)) == kRow8)
+        {
+            promote_to = NewPiece(kCompactPromotionTypes[compact_move >> kCompactPromotionPos], color);
+        }
+
+        return NewMove(from, to, piece, piece_taken, promote_to);
+    }
+}
+
+#endif // M8_CHESS_COMPACT_MOVE_HPP_
@@ -5,6 +5,7 @@
 #ifndef M8_IPERFT_OBSERVER_HPP_
 #define M8_IPERFT_OBSERVER_HPP_
 
+#include <cstdint>
 #include <string>
 
 #include "Types.hpp"
@@ -28,6 +29,27 @@ namespace m8 {
         /// @param time  The time used to complete the test
         virtual void OnPerftCompleted(std::uint64_t count, double time) {}
     };
+
+    /// Observer that keeps the result of a perft test.
+    class PerftCountObserver : public IPerftObserver
+    {
+    public:
+        void OnPerftCompleted(std::uint64_t count, double time)
+        {
+            count_ = count;
+            time_ = time;
+        }
+
+        /// Returns the number of nodes counted.
+        std::uint64_t count() const { return count_; }
+
+        /// Returns the time used by the test.
+        double time() const { return time_; }
+
+    private:
+        std::uint64_t count_ = 0;
+        double time_ = 0;
+    };
 }
 
 #endif // M8_IPERFT_OBSERVER_HPP_
\ No newline at end of file
@@ -223,6 +223,16 @@ namespace m8
     {
         return (move >> kCastlingPos) & ((1 << kCastlingSize) - 1);
     }
+
+    /// Indicate if a move is a quiet move. A quiet move is neither a capture nor a 
+    /// promotion.
+    ///
+    /// @param move The move to check.
+    /// @return True if the move is a quiet move.
+    inline bool IsQuiet(Move move)
+    {
+        return GetPieceTaken(move) == kNoPiece && GetPromoteTo(move) == kNoPiece;
+    }
 }
 
 #endif
\ No newline at end of file
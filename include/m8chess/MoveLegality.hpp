@@ -53,6 +53,12 @@ namespace m8
                 return false;
             }
         }
+        else if (kNoCastling == GetCastling(move) && board[to] != kNoPiece)
+        {
+            // A move that is not a capture must go to an empty square. Castling moves
+            // are excluded because in Chess960 the king can move to the rook square.
+            return false;
+        }
 
         // If it's a castling move, check that it is legal, that the squares 
         // between the rook and king original and final positions are empty and
@@ -69,18 +75,21 @@ namespace m8
             auto row = GetRow(from);
             auto rook_original_column = board.casle_colmn(castle_type);
             auto rook_position = NewSq(rook_original_column, row);
-            auto rook_final_column = castle_type = kQueenSideCastle ? kColmnD : kColmnF;
+            auto rook_final_column = castle_type == kQueenSideCastle ? kColmnD : kColmnF;
             auto rook_final_position = NewSq(rook_final_column, row);
 
             Bb bb_travel_king = BbBetween(from, to);
             Bb bb_travel_rook = BbBetween(rook_position, rook_final_position);
 
-            // Check if any of the travel squared is occupied.
+            // Check if any of the travel squared is occupied. In Chess960 the final
+            // squares of the king and the rook are not always between their origin
+            // and the other piece, so they are checked too.
             Bb occ = board.bb_occupied();
             auto bb_king = GetSingleBitBb(from);
             auto bb_rook = GetSingleBitBb(rook_position);
             occ ^= bb_king | bb_rook;
-            bool travel_occupied = (occ & (bb_travel_king | bb_travel_rook)) != kEmptyBb;
+            Bb bb_final = GetSingleBitBb(to) | GetSingleBitBb(rook_final_position);
+            bool travel_occupied = (occ & (bb_travel_king | bb_travel_rook | bb_final)) != kEmptyBb;
             if (travel_occupied)
             {
                 return false;
@@ -128,6 +137,67 @@ namespace m8
 
         return true;
     }
+
+    /// Check if a pseudo legal move is legal, that is if it does not leave the king of
+    /// the side making it in check. The verification is made without making the move.
+    inline bool IsLegal(const Board& board, Move move)
+    {
+        assert(IsPseudoLegal(board, move));
+
+        auto piece = GetPiece(move);
+        auto color = GetColor(piece);
+        auto from = GetFrom(move);
+        auto to = GetTo(move);
+        auto bb_from = GetSingleBitBb(from);
+        auto bb_to = GetSingleBitBb(to);
+        Bb bb_opponents = board.bb_color(OpposColor(color));
+        Bb occ = board.bb_occupied();
+
+        // The destination of the king must not be attacked once the king and, when 
+        // castling, the rook have left their squares.
+        if (kKing == GetPieceType(piece))
+        {
+            occ ^= bb_from;
+            auto castle_type = GetCastling(move);
+            if (kNoCastling != castle_type)
+            {
+                occ &= ~GetSingleBitBb(NewSq(board.casle_colmn(castle_type), GetRow(from)));
+            }
+            return (movegen::AttacksTo(board, to, occ) & bb_opponents) == kEmptyBb;
+        }
+
+        Sq king_sq = GetLsb(board.bb_piece(NewPiece(kKing, color)));
+
+        // The prise en passant removes two pieces from the board. We verify that the 
+        // king is not attacked after the move.
+        auto piece_taken = GetPieceTaken(move);
+        if (kPawn == GetPieceType(piece) && IsPiece(piece_taken) && board[to] == kNoPiece)
+        {
+            auto bb_captured = GetSingleBitBb(NewSq(GetColmn(to), GetRow(from)));
+            occ ^= bb_from | bb_to | bb_captured;
+            return (movegen::AttacksTo(board, king_sq, occ) & bb_opponents & ~bb_captured) == kEmptyBb;
+        }
+
+        // When in check the move must capture the checker or block the check.
+        Bb checkers = movegen::AttacksTo(board, king_sq) & bb_opponents;
+        if (checkers != kEmptyBb)
+        {
+            if (1 < GetPopct(checkers)
+                || ((checkers | BbBetween(king_sq, GetLsb(checkers))) & bb_to) == kEmptyBb)
+            {
+                return false;
+            }
+        }
+
+        // A pinned piece must stay on the line between it's king and the pinner.
+        if ((movegen::GetPinnedPieces(board, color) & bb_from) != kEmptyBb)
+        {
+            return (BbBetween(king_sq, from) & bb_to) != kEmptyBb
+                || (BbBetween(king_sq, to) & bb_from) != kEmptyBb;
+        }
+
+        return true;
+    }
 }
 
 #endif // M8_CHESS_MOVE_LEGALITY_HPP_
\ No newline at end of file
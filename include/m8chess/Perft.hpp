@@ -7,142 +7,135 @@
 #define M8_PERFT_HPP_
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <functional>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <numeric>
 #include <ranges>
+#include <span>
 #include <thread>
 #include <vector>
 
+#include "../m8common/WorkStealingDeque.hpp"
+#include "../m8common/options/Options.hpp"
+
 #include "IPerftObserver.hpp"
+#include "PerftCheckpoint.hpp"
+#include "PerftHashTable.hpp"
 
 #include "Board.hpp"
 
 namespace m8
 {
-    /// Status of a move in a perft node
-    enum class PerftMoveStatus
-    {
-        /// Indicate that the move need to be searched.
-        New,
-
-        /// Indicate that a thread is already searching this move.
-        Searching,
-
-        /// Indicate that this move is shared. A PerftNode corresponding to the position
-        /// resulting from this move exists.
-        Shared,
-
-        /// The Move has already been searched and the number of leaf nodes is known.
-        Done
-    };
-
     // Forward declaration
     class PerftNode;
 
-    /// Represents a move in a perft node
+    /// Represents a move in a perft node. A move is also the unit of work that the perft
+    /// threads exchange.
     class PerftMove
     {
     public:
         /// Constructor
         ///
-        /// @param move Chess move represented by this PerftMove
-        PerftMove(Move move)
+        /// @param move   Chess move represented by this PerftMove
+        /// @param parent Node where the move is played
+        PerftMove(Move move, PerftNode* parent)
         : move_(move),
-          status_(PerftMoveStatus::New),
-          node_(nullptr)
+          parent_(parent),
+          child_(nullptr),
+          count_(0)
         {}
 
-        /// Returns the status  of the move.
-        PerftMoveStatus status() const { return status_; }
-
         /// Returns the move.
         Move move() const { return move_; }
 
-        /// Return the perft node following this move
-        PerftNode& node() const
-        {
-            assert(status_ == PerftMoveStatus::Shared);
-            return *node_;
-        }
-
-        /// Return the nodes count for this move.
-        std::uint64_t count() const
-        {
-            assert(status_ == PerftMoveStatus::Done);
-            return count_;
-        }
+        /// Returns the node where the move is played.
+        PerftNode& parent() const { return *parent_; }
 
-        /// Change this node to a shared node.
-        void MakeShared(std::unique_ptr<PerftNode> node)
-        {
-            assert(status_ == PerftMoveStatus::New);
-            status_ = PerftMoveStatus::Shared;
-            node_ = std::move(node);
-        }
+        /// Returns the nodes count for this move.
+        std::uint64_t count() const { return count_; }
 
-        /// Change the status of the node to Searching.
-        void MakeSearching()
-        {
-            assert(status_ == PerftMoveStatus::New);
-            status_ = PerftMoveStatus::Searching;
-        }
+        /// Set the nodes count for this move.
+        void set_count(std::uint64_t count) { count_ = count; }
 
-        /// Change the status of the node to done.
-        void CheckSharedDone();
+        /// Split the work under this move by creating the node following the move.
+        ///
+        /// @param arena Arena where the node is allocated.
+        /// @param board Position after the move.
+        /// @param depth Remaining depth after the move.
+        /// @return The node following the move.
+        PerftNode& Split(std::pmr::memory_resource& arena, const Board& board, int depth);
 
-        /// Change the status of the node to done.
-        void MakeDone(std::uint64_t count)
-        {
-            assert(status_ == PerftMoveStatus::Searching || status_ == PerftMoveStatus::New);
-            status_ = PerftMoveStatus::Done;
-            count_ = count;
-        }
+        /// Destroy the node following the move once it's completed. The memory is only
+        /// reclaimed with the arena.
+        void ReleaseChild();
 
     private:
-        Move                       move_;
-        PerftMoveStatus            status_;
-        std::unique_ptr<PerftNode> node_;
-        std::uint64_t              count_;
+        Move          move_;
+        PerftNode*    parent_;
+        PerftNode*    child_;
+        std::uint64_t count_;
     };
 
-    /// Represent a shared node during a perft test
+    /// Represent a split node during a perft test. The children are searched in
+    /// parallel and the node keeps track of the number of children still to complete.
+    /// The nodes are allocated in an arena with their moves stored right after them.
     class PerftNode
     {
     public:
-        /// Constructor
+        /// Create a node in an arena.
         ///
-        /// @param board position at the current node
-        PerftNode(Board& board);
+        /// @param arena       Arena where the node and its moves are allocated
+        /// @param board       Position at the node
+        /// @param depth       Remaining depth at the node
+        /// @param parent_move Move leading to this node or nullptr at the root
+        static PerftNode* Create(std::pmr::memory_resource& arena,
+                                 const Board& board,
+                                 int depth,
+                                 PerftMove* parent_move);
 
-        /// Returns an iterator to the first move.
-        inline std::vector<PerftMove>::iterator begin() { return moves_.begin(); }
+        /// Returns a pointer to the first move.
+        inline PerftMove* begin() { return moves_; }
 
-        /// Returns an iterator one position past the last move.
-        inline std::vector<PerftMove>::iterator end() { return moves_.end(); }
+        /// Returns a pointer one position past the last move.
+        inline PerftMove* end() { return moves_ + size_; }
 
-        /// Indicates if all the moves of this node are done.
-        inline bool done() const
-        {
-            return std::ranges::all_of(moves_,
-                                       [](const PerftMove& move){ return move.status() == PerftMoveStatus::Done; });
-        }
+        /// Returns the position at this node.
+        inline const Board& board() const { return board_; }
+
+        /// Returns the remaining depth at this node.
+        inline int depth() const { return depth_; }
+
+        /// Returns the move leading to this node or nullptr at the root.
+        inline PerftMove* parent_move() const { return parent_move_; }
+
+        /// Release one reference on the node. The node starts with one reference per
+        /// move plus one for the thread that creates it.
+        ///
+        /// @return True if it was the last reference, meaning that all the moves are
+        ///         done.
+        inline bool Release() { return pending_.fetch_sub(1, std::memory_order_acq_rel) == 1; }
 
         /// Returns the sum of the count of all moves at this node.
         inline std::uint64_t count() const
         {
-            auto counts = moves_
+            auto counts = std::span(moves_, size_)
                             | std::views::transform([](const PerftMove& move){ return move.count(); })
                             | std::views::common;
             return std::accumulate(counts.begin(), counts.end(), UINT64_C(0));
         }
 
-
     private:
-        std::vector<PerftMove> moves_;
+        Board board_;
+        int depth_;
+        PerftMove* parent_move_;
+        std::atomic<std::size_t> pending_;
+        PerftMove* moves_;
+        std::size_t size_;
 
-        void GenerateMoves(Board& board);
+        PerftNode(const Board& board, int depth, PerftMove* parent_move, PerftMove* moves, std::size_t size);
     };
 
     /// Classes responsible for running a performance test.
@@ -150,47 +143,91 @@ namespace m8
     {
     public:
         /// Constructor
-        inline Perft(int depth, const Board& board, IPerftObserver* observer)
-            : depth_(depth),
-              board_(board),
-              root_(board_),
-              observer_(observer)
-        {}
+        ///
+        /// @param depth           Depth of the test.
+        /// @param board           Position to test.
+        /// @param observer        Observer notified of the results.
+        /// @param checkpoint_file Name of the checkpoint file used to resume the test. An
+        ///                        empty string disable the checkpoints.
+        Perft(int depth, const Board& board, IPerftObserver* observer, const std::string& checkpoint_file = "");
+
+        /// Constructor. The test uses a hash table that can be shared with other tests.
+        ///
+        /// @param depth      Depth of the test.
+        /// @param board      Position to test.
+        /// @param observer   Observer notified of the results.
+        /// @param hash_table Hash table used by the test.
+        /// @param threads    Number of threads used by the test.
+        Perft(int depth, const Board& board, IPerftObserver* observer, PerftHashTable& hash_table, int threads);
 
-        /// Destructor.
-        ~Perft() { JoinThreads(); };
+        /// Destructor. The whole tree is freed at once with the arenas.
+        ~Perft();
 
         /// Run the test in prallel.
         void Run();
 
+        /// Returns the total time the threads spent without work during the last run:
+        /// looking for a move to steal while the other threads split the tree or finish
+        /// the last subtrees.
+        std::chrono::steady_clock::duration idle_time() const;
+
     private:
+        /// State owned by a perft thread.
+        struct Worker
+        {
+            /// Queue of moves that the other threads can steal.
+            WorkStealingDeque<PerftMove, 4096> queue;
+
+            /// Arena where the thread allocates the nodes it splits.
+            std::pmr::monotonic_buffer_resource arena{kArenaBlockSize};
+
+            /// Time spent by the thread without work.
+            std::chrono::steady_clock::duration idle_time{0};
+        };
+
+        static const std::size_t kArenaBlockSize = 64 * 1024;
+
         const int kMinParallelDepth = 3;
 
+        /// Maximum ply of a split node. The arenas are only freed at the end of the test,
+        /// so the number of split nodes must be bounded.
+        const int kMaxSplitPly = 3;
+
+        /// Number of plies at the bottom of the tree that are unrolled at compile time.
+        static const int kUnrolledDepth = 2;
+
         int depth_;
         Board board_;
 
         std::chrono::steady_clock::time_point start_;
 
-        PerftNode root_;
+        std::pmr::monotonic_buffer_resource arena_;
+        PerftNode* root_;
+
+        std::unique_ptr<PerftHashTable> owned_hash_table_;
+        PerftHashTable* hash_table_;
+
+        std::unique_ptr<PerftCheckpoint> checkpoint_;
+
+        int threads_count_;
 
+        std::vector<std::unique_ptr<Worker>> workers_;
         std::vector<std::thread> threads_;
-        std::mutex mutex_;
+        std::atomic<bool> done_;
 
+        std::mutex observer_mutex_;
         IPerftObserver* observer_;
 
         std::uint64_t RecursivePerft(Board& board, int depth);
-        void ContributeAtSharedNode(PerftNode& node, Board& board, int depth);
-        void PerftMoveRecursive(PerftMove& move, Board& board, int depth);
-        void ParallelPerft(PerftNode& node,
-                           Board& board,
-                           int depth,
-                           PerftMoveStatus node_type,
-                           bool is_root,
-                           std::function<void(PerftMove&, Board&, int)> recurse);
-        void FindNodeToContribute(PerftNode& node, Board& board, int depth, bool is_root);
+        template<int kDepth> std::uint64_t UnrolledPerft(Board& board);
+        void Execute(PerftMove& move, Worker& worker);
+        void Complete(PerftMove& move, std::uint64_t count);
+        void Release(PerftNode& node);
+        PerftCheckpoint::Path GetPath(const PerftMove& move) const;
+        PerftMove* Steal(std::size_t thief);
         void StartThreads();
         void JoinThreads();
-        void RunThread();
+        void RunThread(std::size_t index);
         void SendResult();
     };
 }
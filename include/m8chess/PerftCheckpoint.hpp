@@ -0,0 +1,91 @@
+/// @file PerftCheckpoint.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains the checkpoint file that allows to resume a perft test.
+
+#ifndef M8_PERFT_CHECKPOINT_HPP_
+#define M8_PERFT_CHECKPOINT_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Move.hpp"
+
+#include "transposition/Zobrist.hpp"
+
+namespace m8
+{
+    /// Exception thrown when a checkpoint file can't be used.
+    class PerftCheckpointError : public std::runtime_error
+    {
+    public:
+        /// Constructor
+        PerftCheckpointError(const std::string& what_arg)
+            : std::runtime_error(what_arg)
+        {};
+    };
+
+    /// Checkpoint of a perft test. The node counts of the completed subtrees are appended
+    /// to a binary file. When the test is started again with the same file, the subtrees
+    /// already completed are not counted again.
+    ///
+    /// The file starts with a header (magic number, version, hash key of the root
+    /// position and depth) followed by records made of the moves leading to the subtree
+    /// and its node count. The values are stored in the native byte order.
+    class PerftCheckpoint
+    {
+    public:
+        /// Sequence of moves from the root position to a subtree.
+        typedef std::vector<Move> Path;
+
+        /// Constructor. Open the checkpoint file, or create it if it does not exist.
+        ///
+        /// @param filename Name of the checkpoint file.
+        /// @param key      Hash key of the root position.
+        /// @param depth    Depth of the perft test.
+        PerftCheckpoint(const std::string& filename, transposition::ZobristKey key, int depth);
+
+        /// Try to get the node count of a subtree completed in a previous run.
+        ///
+        /// @param path  Moves leading to the subtree.
+        /// @param count Receive the node count if the subtree was completed.
+        /// @return True if the subtree was completed.
+        bool TryGet(const Path& path, std::uint64_t& count) const;
+
+        /// Record the node count of a completed subtree. This method is thread-safe.
+        ///
+        /// @param path  Moves leading to the subtree.
+        /// @param count Number of leaf nodes of the subtree.
+        void Record(const Path& path, std::uint64_t count);
+
+        /// Returns the number of subtrees completed in previous runs.
+        inline std::size_t restored() const { return restored_.size(); }
+
+    private:
+        static const std::uint32_t kMagic = 0x4B43384D; // "M8CK"
+        static const std::uint32_t kVersion = 1;
+
+        /// Maximum time the records stay in the buffer before being written to the disk.
+        static constexpr std::chrono::seconds kFlushInterval{1};
+
+        std::map<Path, std::uint64_t> restored_;
+
+        std::mutex mutex_;
+        std::ofstream file_;
+        std::chrono::steady_clock::time_point last_flush_;
+
+        /// Read the records of the checkpoint file.
+        ///
+        /// @return The size of the valid part of the file.
+        std::uintmax_t Load(std::ifstream& file, transposition::ZobristKey key, int depth);
+    };
+}
+
+#endif // M8_PERFT_CHECKPOINT_HPP_
@@ -0,0 +1,157 @@
+/// @file PerftHashTable.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains the hash table used to store the node counts of the subtrees
+///        already visited by a perft test.
+
+#ifndef M8_PERFT_HASH_TABLE_HPP_
+#define M8_PERFT_HASH_TABLE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "../m8common/Bb.hpp"
+
+#include "transposition/Zobrist.hpp"
+
+namespace m8
+{
+    /// Entry of the perft hash table. The entry is shared by all the perft threads
+    /// without locks. The key is stored xored with the data so that an entry written
+    /// simultaneously by two threads is detected and ignored.
+    class PerftHashEntry
+    {
+    public:
+        /// Number of bits of the data used to store the depth.
+        static const int kDepthBits = 8;
+
+        /// Try to get the node count of a position.
+        ///
+        /// @param key   Hash key of the position.
+        /// @param depth Remaining depth of the perft test.
+        /// @param count Receive the node count if the entry correspond to the position.
+        /// @return True if the entry correspond to the position and depth.
+        inline bool TryGet(transposition::ZobristKey key, int depth, std::uint64_t& count) const
+        {
+            auto data = data_.load(std::memory_order_relaxed);
+            auto entry_key = key_.load(std::memory_order_relaxed);
+
+            if ((entry_key ^ data) != key || GetDepth(data) != depth)
+            {
+                return false;
+            }
+
+            count = data >> kDepthBits;
+            return true;
+        }
+
+        /// Store the node count of a position.
+        ///
+        /// @param key   Hash key of the position.
+        /// @param depth Remaining depth of the perft test.
+        /// @param count Number of leaf nodes.
+        inline void Set(transposition::ZobristKey key, int depth, std::uint64_t count)
+        {
+            std::uint64_t data = (count << kDepthBits) | static_cast<std::uint64_t>(depth);
+            key_.store(key ^ data, std::memory_order_relaxed);
+            data_.store(data, std::memory_order_relaxed);
+        }
+
+        /// Returns the depth stored in the entry.
+        inline int depth() const { return GetDepth(data_.load(std::memory_order_relaxed)); }
+
+    private:
+        std::atomic<std::uint64_t> key_;
+        std::atomic<std::uint64_t> data_;
+
+        inline static int GetDepth(std::uint64_t data)
+        {
+            return static_cast<int>(data & ((UINT64_C(1) << kDepthBits) - 1));
+        }
+    };
+
+    /// Bucket of the perft hash table. A bucket fill a cache line.
+    class alignas(64) PerftHashBucket
+    {
+    public:
+        /// Try to get the node count of a position.
+        inline bool TryGet(transposition::ZobristKey key, int depth, std::uint64_t& count) const
+        {
+            for (const auto& entry : entries_)
+            {
+                if (entry.TryGet(key, depth, count))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Store the node count of a position. The entry with the smallest depth is
+        /// replaced because it's the cheapest to compute again.
+        inline void Insert(transposition::ZobristKey key, int depth, std::uint64_t count)
+        {
+            auto replaced = &entries_[0];
+            for (auto& entry : entries_)
+            {
+                if (entry.depth() < replaced->depth())
+                {
+                    replaced = &entry;
+                }
+            }
+            replaced->Set(key, depth, count);
+        }
+
+    private:
+        std::array<PerftHashEntry, 4> entries_;
+    };
+
+    /// Hash table shared by all the threads of a perft test. It stores the node count
+    /// of the subtrees so that the subtrees reached by transposition are only counted
+    /// once.
+    class PerftHashTable
+    {
+    public:
+        /// Constructor.
+        ///
+        /// @param size Size of the table in bytes. It is rounded down to a power of two.
+        ///             A size of zero disable the table.
+        inline PerftHashTable(std::size_t size)
+        : buckets_(size < sizeof(PerftHashBucket) ? 0 : (UINT64_C(1) << GetMsb(size)) / sizeof(PerftHashBucket)),
+          mask_(buckets_.size() - 1)
+        {}
+
+        /// Indicate if the table can be used.
+        inline bool enabled() const { return !buckets_.empty(); }
+
+        /// Try to get the node count of a position.
+        ///
+        /// @param key   Hash key of the position.
+        /// @param depth Remaining depth of the perft test.
+        /// @param count Receive the node count if the position is found.
+        /// @return True if the position is found.
+        inline bool TryGet(transposition::ZobristKey key, int depth, std::uint64_t& count) const
+        {
+            return buckets_[key & mask_].TryGet(key, depth, count);
+        }
+
+        /// Store the node count of a position.
+        ///
+        /// @param key   Hash key of the position.
+        /// @param depth Remaining depth of the perft test.
+        /// @param count Number of leaf nodes.
+        inline void Insert(transposition::ZobristKey key, int depth, std::uint64_t count)
+        {
+            buckets_[key & mask_].Insert(key, depth, count);
+        }
+
+    private:
+        std::vector<PerftHashBucket> buckets_;
+        std::uint64_t mask_;
+    };
+}
+
+#endif // M8_PERFT_HASH_TABLE_HPP_
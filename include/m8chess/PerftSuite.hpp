@@ -0,0 +1,98 @@
+/// @file PerftSuite.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains the PerftSuite class that validates the move generation against an
+///        EPD perft file.
+
+#ifndef M8_PERFT_SUITE_HPP_
+#define M8_PERFT_SUITE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "PerftHashTable.hpp"
+
+namespace m8
+{
+    /// Exception thrown when a perft suite file can't be read.
+    class PerftSuiteError : public std::runtime_error
+    {
+    public:
+        /// Constructor
+        PerftSuiteError(const std::string& what_arg)
+            : std::runtime_error(what_arg)
+        {};
+    };
+
+    /// Position of a perft suite with the expected node counts.
+    struct PerftSuitePosition
+    {
+        /// Position to test.
+        std::string fen;
+
+        /// Expected node count at each depth.
+        std::vector<std::pair<int, std::uint64_t>> expected;
+    };
+
+    /// Run the perft tests of an EPD file (e.g. "<fen> ;D1 20 ;D2 400") and check the
+    /// node counts. The tests are run concurrently, each one with a single thread.
+    class PerftSuite
+    {
+    public:
+        /// Constructor
+        ///
+        /// @param filename  Name of the EPD file.
+        /// @param max_depth Maximum depth tested. The deeper tests of the file are skipped.
+        /// @param threads   Number of tests that are run in parallel.
+        /// @param hash_size Size of the hash table shared by all the tests in megabytes. A
+        ///                  size of zero disable the table.
+        PerftSuite(const std::string& filename, int max_depth, std::uint32_t threads, std::uint32_t hash_size);
+
+        /// Run the tests and report the results.
+        ///
+        /// @return True if all the node counts are correct.
+        bool Run();
+
+        /// Parse a line of an EPD perft file.
+        ///
+        /// @param line Line to parse.
+        /// @return The position and its expected node counts.
+        static PerftSuitePosition ParseEpdLine(const std::string& line);
+
+    private:
+        /// A single perft test: one position at one depth.
+        struct Test
+        {
+            std::size_t position;
+            int depth;
+            std::uint64_t expected;
+        };
+
+        /// Results of all the tests of a position.
+        struct PositionResult
+        {
+            std::uint64_t nodes = 0;
+            std::chrono::steady_clock::duration duration{0};
+            std::uint32_t failures = 0;
+        };
+
+        std::vector<PerftSuitePosition> positions_;
+        std::vector<Test> tests_;
+        std::uint32_t threads_count_;
+        std::uint32_t hash_size_;
+
+        std::vector<PositionResult> results_;
+        std::atomic<std::size_t> next_test_;
+        std::mutex mutex_;
+
+        void RunTests(PerftHashTable& hash_table);
+    };
+}
+
+#endif // M8_PERFT_SUITE_HPP_
@@ -0,0 +1,106 @@
+/// @file PerftWorkUnit.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains the work units used to split a perft test between many processes.
+
+#ifndef M8_PERFT_WORK_UNIT_HPP_
+#define M8_PERFT_WORK_UNIT_HPP_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Board.hpp"
+#include "IPerftObserver.hpp"
+#include "Move.hpp"
+
+namespace m8
+{
+    /// Exception thrown when a work unit or a result file can't be used.
+    class PerftWorkUnitError : public std::runtime_error
+    {
+    public:
+        /// Constructor
+        PerftWorkUnitError(const std::string& what_arg)
+            : std::runtime_error(what_arg)
+        {};
+    };
+
+    /// Part of a perft test that can be counted by a separate process. A work unit
+    /// contains a list of paths, sequences of moves from the root position, each leading
+    /// to a subtree to count.
+    ///
+    /// Work units and their results are stored in text files, with the moves in SAN, so
+    /// they can be shared through a directory between machines.
+    class PerftWorkUnit
+    {
+    public:
+        /// Sequence of moves from the root position to a subtree.
+        typedef std::vector<Move> Path;
+
+        /// Constructor
+        ///
+        /// @param fen   Root position of the perft test.
+        /// @param depth Depth of the perft test.
+        PerftWorkUnit(const std::string& fen, int depth)
+        : fen_(fen),
+          depth_(depth)
+        {}
+
+        /// Returns the root position of the perft test.
+        inline const std::string& fen() const { return fen_; }
+
+        /// Returns the depth of the perft test.
+        inline int depth() const { return depth_; }
+
+        /// Returns the paths to the subtrees of this work unit.
+        inline const std::vector<Path>& paths() const { return paths_; }
+
+        /// Add a subtree to this work unit.
+        inline void AddPath(const Path& path) { paths_.push_back(path); }
+
+        /// Count the leaf nodes of each subtree of the work unit.
+        ///
+        /// @return The node count of each path, in the same order as paths().
+        std::vector<std::uint64_t> Run() const;
+
+        /// Split a perft test into work units. The tree is expanded one ply at a time
+        /// until there are enough subtrees for all the work units.
+        ///
+        /// @param board Root position of the test.
+        /// @param depth Depth of the test.
+        /// @param count Number of work units to create.
+        static std::vector<PerftWorkUnit> Split(const Board& board, int depth, std::size_t count);
+
+        /// Read a work unit from a file.
+        static PerftWorkUnit Read(const std::string& filename);
+
+        /// Write the work unit to a file.
+        void Write(const std::string& filename) const;
+
+        /// Write the results of the work unit to a file.
+        ///
+        /// @param filename Name of the result file.
+        /// @param counts   Node count of each path.
+        /// @param time     Time used to count the work unit.
+        void WriteResult(const std::string& filename, const std::vector<std::uint64_t>& counts, double time) const;
+
+        /// Sum the results of all the work units in a directory and report them to an
+        /// observer as if the test was run by a single Perft.
+        ///
+        /// @param directory Directory containing the work units and their results.
+        /// @param observer  Observer notified with the count of each root move and the
+        ///                  total count. The time reported is the sum of the time of all
+        ///                  the work units.
+        static void Merge(const std::string& directory, IPerftObserver& observer);
+
+    private:
+        std::string fen_;
+        int depth_;
+        std::vector<Path> paths_;
+    };
+}
+
+#endif // M8_PERFT_WORK_UNIT_HPP_
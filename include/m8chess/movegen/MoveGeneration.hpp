@@ -25,8 +25,10 @@ namespace m8::movegen
 {
     /// Generate a bitboard of all the squares that attacks a given square.
     ///
-    /// @param sq Square for which we want to get the attackers.
-    inline Bb AttacksTo(const Board& board, Sq sq)
+    /// @param sq  Square for which we want to get the attackers.
+    /// @param occ Occupancy used to generate the attacks of the sliders. Allows to find
+    ///            the attackers as if some pieces had been moved.
+    inline Bb AttacksTo(const Board& board, Sq sq, Bb occ)
     {
         Bb queens = board.bb_piece(kWhiteQueen) | board.bb_piece(kBlackQueen);
         Bb rooks = board.bb_piece(kWhiteRook) | board.bb_piece(kBlackRook);
@@ -34,8 +36,8 @@ namespace m8::movegen
         Bb knights = board.bb_piece(kWhiteKnight) | board.bb_piece(kBlackKnight);
         Bb kings = board.bb_piece(kWhiteKing) | board.bb_piece(kBlackKing);
 
-        Bb attackers = GenerateRookAttacks(board.bb_occupied(), sq) & (queens | rooks);
-        attackers |= GenerateBishopAttacks(board.bb_occupied(), sq) & (queens | bishops);
+        Bb attackers = GenerateRookAttacks(occ, sq) & (queens | rooks);
+        attackers |= GenerateBishopAttacks(occ, sq) & (queens | bishops);
         attackers |= knight_attack_bb[sq] & knights;
         attackers |= king_attack_bb[sq] & kings;
 
@@ -46,6 +48,14 @@ namespace m8::movegen
         return attackers;
     }
 
+    /// Generate a bitboard of all the squares that attacks a given square.
+    ///
+    /// @param sq Square for which we want to get the attackers.
+    inline Bb AttacksTo(const Board& board, Sq sq)
+    {
+        return AttacksTo(board, sq, board.bb_occupied());
+    }
+
     /// Generate a bitboard of all square that a given square attacks.
     inline Bb AttacksFrom(const Board& board, Sq sq)
     {
@@ -271,13 +281,15 @@ namespace m8::movegen
         }
 
         // Check if any of the square traveled by the king or the origin or 
-        // destination of the king are under attack.
+        // destination of the king are under attack. The castling rook is removed from 
+        // the occupancy because in Chess960 it might hide an attack on the king final
+        // position.
         Bb bb_opponents = board.bb_color(OpposColor(color));
 
         while (bb_travel_king)
         {
             Sq pos = RemoveLsb(bb_travel_king);
-            if ((AttacksTo(board, pos) & bb_opponents) != kEmptyBb)
+            if ((AttacksTo(board, pos, occ) & bb_opponents) != kEmptyBb)
             {
                 return;
             }
@@ -631,8 +643,9 @@ namespace m8::movegen
         GenerateCaptures(board, color, move_list);
     }
 
-    /// Returns a bitboard of the pinned pieces of a give color.
-    inline Bb GetPinnedPieces(const Board& board, Color color)
+    /// Returns a bitboard of the opponent sliders that pin a piece of a given color
+    /// on it's king.
+    inline Bb GetPinners(const Board& board, Color color)
     {
         Sq king_sq = GetLsb(board.bb_piece(NewPiece(kKing, color)));
         Color attacker_color = OpposColor(color);
@@ -643,8 +656,16 @@ namespace m8::movegen
         Bb occ = board.bb_occupied();
         Bb blockers = board.bb_color(color);
 
-        Bb pinners = (GenerateRookXRay(occ, blockers, king_sq) & attacker_like_rook)
-                   | (GenerateBishopXRay(occ, blockers, king_sq) & attacker_like_bishop);
+        return (GenerateRookXRay(occ, blockers, king_sq) & attacker_like_rook)
+             | (GenerateBishopXRay(occ, blockers, king_sq) & attacker_like_bishop);
+    }
+
+    /// Returns a bitboard of the pinned pieces of a give color.
+    inline Bb GetPinnedPieces(const Board& board, Color color)
+    {
+        Sq king_sq = GetLsb(board.bb_piece(NewPiece(kKing, color)));
+        Bb blockers = board.bb_color(color);
+        Bb pinners = GetPinners(board, color);
 
         Bb pinned = kEmptyBb;
         while (pinners)
@@ -656,6 +677,246 @@ namespace m8::movegen
 
         return pinned;
     }
+
+    /// Returns the target squares of the legal move generator.
+    ///
+    /// @tparam captures    Indicate if the squares occupied by the opponent are targets.
+    /// @tparam quiet_moves Indicate if the empty squares are targets.
+    /// @param color        Color of the side to move.
+    template<bool captures, bool quiet_moves>
+    inline Bb GetLegalTargets(const Board& board, Color color)
+    {
+        Bb targets = kEmptyBb;
+        if constexpr (captures)
+        {
+            targets |= board.bb_color(OpposColor(color));
+        }
+        if constexpr (quiet_moves)
+        {
+            targets |= ~board.bb_occupied();
+        }
+        return targets;
+    }
+
+    /// Generate the legal moves of the king. The king is removed from the occupancy
+    /// before checking if a destination is attacked so that it can't move away from a 
+    /// slider along the line of the attack.
+    ///
+    /// @param color     Color of the king.
+    /// @param king_sq   Position of the king.
+    /// @param move_list List in which to add moves.
+    template<bool captures, bool quiet_moves>
+    inline void GenerateLegalKingMoves(const Board& board, Color color, Sq king_sq, MoveList& move_list)
+    {
+        Piece king = NewPiece(kKing, color);
+        Bb occ = board.bb_occupied() ^ GetSingleBitBb(king_sq);
+        Bb bb_opponents = board.bb_color(OpposColor(color));
+        Bb destinations = king_attack_bb[king_sq] & GetLegalTargets<captures, quiet_moves>(board, color);
+
+        while (destinations)
+        {
+            Sq to = RemoveLsb(destinations);
+            if ((AttacksTo(board, to, occ) & bb_opponents) == kEmptyBb)
+            {
+                move_list.Push(NewMove(king_sq, to, king, board[to]));
+            }
+        }
+    }
+
+    /// Generate the legal pawn moves, except the prise en passant. Promotions are
+    /// considered captures.
+    ///
+    /// @param color     Color of the pawns.
+    /// @param bb_from   Pawns for which to generate the moves.
+    /// @param mask      Destinations allowed by the checks and pins.
+    /// @param move_list List in which to add moves.
+    template<bool captures, bool quiet_moves>
+    inline void GenerateLegalPawnMoves(const Board& board, Color color, Bb bb_from, Bb mask, MoveList& move_list)
+    {
+        Piece piece = NewPiece(kPawn, color);
+        Row third_row = kRow3 + 3 * color;
+        Row eighth_row = 7 - 7 * color;
+        int forward_move = 8 - 16 * color;
+        int forward_left = 7 - 16 * color;
+        int forward_right = 9 - 16 * color;
+
+        Bb pawns = board.bb_piece(piece) & bb_from;
+        Bb empty = ~board.bb_occupied();
+
+        // The two squares moves must be computed before applying the mask because the
+        // square jumped over does not need to be an allowed destination.
+        Bb target = pawns;
+        Shift(target, forward_move);
+        target &= empty;
+
+        Bb target_dbl = target & kBbRow[third_row];
+        Shift(target_dbl, forward_move);
+        target_dbl &= empty & mask;
+        target &= mask;
+
+        if constexpr (captures)
+        {
+            Bb bb_opponents = board.bb_color(OpposColor(color)) & mask;
+
+            Bb target_left = pawns & ~kBbColmn[kColmnA];
+            Shift(target_left, forward_left);
+            UnpackPawnMoves(board, color, target_left & bb_opponents, -forward_left, move_list);
+
+            Bb target_right = pawns & ~kBbColmn[kColmnH];
+            Shift(target_right, forward_right);
+            UnpackPawnMoves(board, color, target_right & bb_opponents, -forward_right, move_list);
+
+            UnpackPawnMoves(board, color, target & kBbRow[eighth_row], -forward_move, move_list);
+        }
+
+        if constexpr (quiet_moves)
+        {
+            UnpackPawnMoves(board, color, target & ~kBbRow[eighth_row], -forward_move, move_list);
+            UnpackPawnMoves(board, color, target_dbl, -forward_move * 2, move_list);
+        }
+    }
+
+    /// Generate the legal moves of the knights, bishops, rooks and queens.
+    ///
+    /// @param color     Color of the pieces.
+    /// @param bb_from   Pieces for which to generate the moves.
+    /// @param targets   Destinations allowed.
+    /// @param move_list List in which to add moves.
+    inline void GenerateLegalPieceMoves(const Board& board, Color color, Bb bb_from, Bb targets, MoveList& move_list)
+    {
+        Bb pieces = bb_from
+                  & ~board.bb_piece(NewPiece(kPawn, color))
+                  & ~board.bb_piece(NewPiece(kKing, color));
+
+        while (pieces)
+        {
+            Sq from = RemoveLsb(pieces);
+            Bb bb_to = AttacksFrom(board, from) & targets;
+
+            while (bb_to)
+            {
+                Sq to = RemoveLsb(bb_to);
+                move_list.Push(NewMove(from, to, board[from], board[to]));
+            }
+        }
+    }
+
+    /// Generate the legal prise en passant. The capture removes two pieces from the 
+    /// board, possibly on the same row as the king, so it's simpler to verify that the
+    /// king is not attacked after the move.
+    ///
+    /// @param color     Color of the side to move.
+    /// @param king_sq   Position of the king.
+    /// @param move_list List in which to add moves.
+    inline void GenerateLegalPriseEnPassant(const Board& board, Color color, Sq king_sq, MoveList& move_list)
+    {
+        Colmn enpas = board.colmn_enpas();
+        if (!IsColmnOnBoard(enpas))
+        {
+            return;
+        }
+
+        Piece pawn = NewPiece(kPawn, color);
+        Piece captured = NewPiece(kPawn, OpposColor(color));
+        Sq to = NewSq(enpas, GetColorWiseRow(color, kRow6));
+        Bb bb_captured = GetSingleBitBb(NewSq(enpas, GetColorWiseRow(color, kRow5)));
+        Bb bb_opponents = board.bb_color(OpposColor(color)) & ~bb_captured;
+        Bb bb_from = GeneratePawnAttacksTo(color, to) & board.bb_piece(pawn);
+
+        while (bb_from)
+        {
+            Sq from = RemoveLsb(bb_from);
+            Bb occ = board.bb_occupied() ^ GetSingleBitBb(from) ^ GetSingleBitBb(to) ^ bb_captured;
+            if ((AttacksTo(board, king_sq, occ) & bb_opponents) == kEmptyBb)
+            {
+                move_list.Push(NewMove(from, to, pawn, captured));
+            }
+        }
+    }
+
+    /// Generate the legal moves for the side on move. The checkers and the pins are 
+    /// computed once. When in double check only the king can move. When in single 
+    /// check the other pieces must capture the checker or block the check. Pinned 
+    /// pieces can only move along the line between their king and the pinner.
+    ///
+    /// @tparam captures    Indicate if the captures and promotions are generated.
+    /// @tparam quiet_moves Indicate if the other moves are generated.
+    /// @param move_list    List in which to add moves.
+    template<bool captures, bool quiet_moves>
+    inline void GenerateLegal(const Board& board, MoveList& move_list)
+    {
+        Color color = board.side_to_move();
+        Sq king_sq = GetLsb(board.bb_piece(NewPiece(kKing, color)));
+        Bb bb_own = board.bb_color(color);
+        Bb checkers = AttacksTo(board, king_sq) & board.bb_color(OpposColor(color));
+
+        GenerateLegalKingMoves<captures, quiet_moves>(board, color, king_sq, move_list);
+
+        if (1 < GetPopct(checkers))
+        {
+            return;
+        }
+
+        // Evasions. When in check, the other pieces must capture the checker or move 
+        // between the checker and the king.
+        Bb mask = kFilledBb;
+        if (checkers != kEmptyBb)
+        {
+            mask = checkers | BbBetween(king_sq, GetLsb(checkers));
+        }
+        else if constexpr (quiet_moves)
+        {
+            GenerateCastlingMoves(board, color, move_list);
+        }
+
+        // Pinned pieces can only move along the line of the pin.
+        Bb targets = GetLegalTargets<captures, quiet_moves>(board, color);
+        Bb pinned = kEmptyBb;
+        Bb pinners = GetPinners(board, color);
+        while (pinners)
+        {
+            Sq pinner_sq = RemoveLsb(pinners);
+            Bb pin_ray = BbBetween(king_sq, pinner_sq) | GetSingleBitBb(pinner_sq);
+            Bb bb_pinned = pin_ray & bb_own;
+            pinned |= bb_pinned;
+
+            GenerateLegalPawnMoves<captures, quiet_moves>(board, color, bb_pinned, mask & pin_ray, move_list);
+            GenerateLegalPieceMoves(board, color, bb_pinned, targets & mask & pin_ray, move_list);
+        }
+
+        Bb bb_free = bb_own & ~pinned;
+        GenerateLegalPawnMoves<captures, quiet_moves>(board, color, bb_free, mask, move_list);
+        GenerateLegalPieceMoves(board, color, bb_free, targets & mask, move_list);
+
+        if constexpr (captures)
+        {
+            GenerateLegalPriseEnPassant(board, color, king_sq, move_list);
+        }
+    }
+
+    /// Generate all legal moves for the side on move.
+    ///
+    /// @param move_list List in which to add moves.
+    inline void GenerateLegalMoves(const Board& board, MoveList& move_list)
+    {
+        GenerateLegal<true, true>(board, move_list);
+    }
+
+    /// Generate the legal captures and promotions for the side on move.
+    ///
+    /// @param move_list List in which to add moves.
+    inline void GenerateLegalCaptures(const Board& board, MoveList& move_list)
+    {
+        GenerateLegal<true, false>(board, move_list);
+    }
+
+    /// Generate the legal quiet moves for the side on move.
+    ///
+    /// @param move_list List in which to add moves.
+    inline void GenerateLegalQuietMoves(const Board& board, MoveList& move_list)
+    {
+        GenerateLegal<false, true>(board, move_list);
+    }
 }
 
 #endif // M8_CHESS_MOVEGEN_MOVE_GENERATION_HPP_
@@ -18,7 +18,9 @@
 #include "../Types.hpp"
 
 #include "MoveGeneration.hpp"
+#include "MoveOrdering.hpp"
 #include "MvvLva.hpp"
+#include "See.hpp"
 
 namespace m8::movegen
 {
@@ -43,7 +45,8 @@ namespace m8::movegen
             inline Iterator(const Iterator& original)
             : generator_(original.generator_),
               current_step_(original.current_step_),
-              moves_(original.moves_)
+              moves_(original.moves_),
+              bad_captures_(original.bad_captures_)
             {}
 
             /// Constructor for a new iterator
@@ -71,6 +74,7 @@ namespace m8::movegen
                 generator_    = rhs.generator_;
                 current_step_ = rhs.current_step_;
                 moves_        = rhs.moves_;
+                bad_captures_ = rhs.bad_captures_;
                 return *this;
             }
 
@@ -120,7 +124,8 @@ namespace m8::movegen
                 {
                 case GenerationStep::UseTranspositionMove:
                     if (generator_->data_.tt_move_ != kNullMove 
-                        && IsPseudoLegal(*(generator_->data_.board_), generator_->data_.tt_move_))
+                        && IsPseudoLegal(*(generator_->data_.board_), generator_->data_.tt_move_)
+                        && IsLegal(*(generator_->data_.board_), generator_->data_.tt_move_))
                     {
                         current_move_ = generator_->data_.tt_move_;
                         current_step_ = GenerationStep::GenerateCaptures;
@@ -131,57 +136,41 @@ namespace m8::movegen
 
                 case GenerationStep::GenerateCaptures:
                     // Generate all captures
-                    movegen::GenerateAllCaptures(*(generator_->data_.board_), moves_);
+                    movegen::GenerateLegalCaptures(*(generator_->data_.board_), moves_);
                     
-                    // Score all captures using MVV/LVA, keep track of the best one and
-                    // make it the current move.
+                    // Score all captures using MVV/LVA. The captures that lose material
+                    // according to the static exchange evaluation are moved to the bad
+                    // captures list. In the qsearch they are not searched at all.
+                    for (size_t x = 0; x < moves_.size(); ++x)
                     {
-                        size_t indx_best = -1;
-                        EvalType best_eval = eval::kMinEval;
-                        for (size_t x = 0; x < moves_.size(); ++x)
+                        auto move = moves_[x].move;
+                        if (generator_->data_.tt_move_ == move)
                         {
-                            if (generator_->data_.tt_move_ == moves_[x].move)
-                            {
-                                moves_.Erase(x--);
-                            }
-                            else
+                            moves_.Erase(x--);
+                        }
+                        else if (IsLosingCapture(move))
+                        {
+                            if (!qsearch)
                             {
-                                moves_[x].eval = GetMvvLvaValue(moves_[x].move);
-                                if (best_eval < moves_[x].eval)
-                                {
-                                    best_eval = moves_[x].eval;
-                                    indx_best = x;
-                                }
+                                bad_captures_.Push(move);
+                                bad_captures_[bad_captures_.size() - 1].eval = GetMvvLvaValue(move);
                             }
+                            moves_.Erase(x--);
                         }
-                        if (best_eval != eval::kMinEval)
+                        else
                         {
-                            current_move_ = moves_[indx_best].move;
-                            moves_.Erase(indx_best);
-                            current_step_ = GenerationStep::DistributeCaptures;
-                            return;
+                            moves_[x].eval = GetMvvLvaValue(move);
                         }
                     }
 
-                    current_step_ = GenerationStep::DistributeCaptures;
+                    current_step_ = GenerationStep::DistributeGoodCaptures;
                     /* Intentionally ommited break */
 
-                case GenerationStep::DistributeCaptures:
+                case GenerationStep::DistributeGoodCaptures:
                     // Find the best capture and make it the current move
                     if (moves_.any())
                     {
-                        size_t indx_best = 0;
-                        EvalType best_eval = eval::kMinEval;
-                        for (size_t x = 0; x < moves_.size(); ++x)
-                        {
-                            if (best_eval < moves_[x].eval)
-                            {
-                                best_eval = moves_[x].eval;
-                                indx_best = x;
-                            }
-                        }
-                        current_move_ = moves_[indx_best].move;
-                        moves_.Erase(indx_best);
+                        current_move_ = PopBestMove(moves_);
                         return;
                     }
 
@@ -193,29 +182,80 @@ namespace m8::movegen
                         return;
                     }
 
+                    current_step_ = GenerationStep::UseFirstKiller;
+                    /* Intentionally ommited break */
+
+                case GenerationStep::UseFirstKiller:
+                    current_step_ = GenerationStep::UseSecondKiller;
+                    if (IsUsableQuietMove(generator_->data_.killers_[0]))
+                    {
+                        current_move_ = generator_->data_.killers_[0];
+                        return;
+                    }
+                    /* Intentionally ommited break */
+
+                case GenerationStep::UseSecondKiller:
+                    current_step_ = GenerationStep::UseCounterMove;
+                    if (IsUsableQuietMove(generator_->data_.killers_[1]))
+                    {
+                        current_move_ = generator_->data_.killers_[1];
+                        return;
+                    }
+                    /* Intentionally ommited break */
+
+                case GenerationStep::UseCounterMove:
                     current_step_ = GenerationStep::GenerateQuietMoves;
+                    if (generator_->data_.counter_move_ != generator_->data_.killers_[0]
+                        && generator_->data_.counter_move_ != generator_->data_.killers_[1]
+                        && IsUsableQuietMove(generator_->data_.counter_move_))
+                    {
+                        current_move_ = generator_->data_.counter_move_;
+                        return;
+                    }
                     /* Intentionally ommited break */
 
                 case GenerationStep::GenerateQuietMoves:
-                    movegen::GenerateAllQuietMoves(*(generator_->data_.board_), moves_);
-                    current_step_ = GenerationStep::DistributeRemainingMoves;
-                    /* Intentionally ommited break */
+                    movegen::GenerateLegalQuietMoves(*(generator_->data_.board_), moves_);
 
-                case GenerationStep::DistributeRemainingMoves:
-                    // Remove the TT move if it's the next move
-                    if (moves_.any() && generator_->data_.tt_move_ == moves_.back())
+                    // Remove the moves already distributed and score the others with the
+                    // history heuristic.
+                    for (size_t x = 0; x < moves_.size(); ++x)
                     {
-                        moves_.Pop();
+                        auto move = moves_[x].move;
+                        if (move == generator_->data_.tt_move_
+                            || move == generator_->data_.killers_[0]
+                            || move == generator_->data_.killers_[1]
+                            || move == generator_->data_.counter_move_)
+                        {
+                            moves_.Erase(x--);
+                        }
+                        else
+                        {
+                            moves_[x].eval = generator_->data_.move_ordering_ != nullptr
+                                           ? generator_->data_.move_ordering_->history(move)
+                                           : 0;
+                        }
                     }
+                    current_step_ = GenerationStep::DistributeQuietMoves;
+                    /* Intentionally ommited break */
 
+                case GenerationStep::DistributeQuietMoves:
                     if (moves_.any())
                     {
-                        current_move_ = moves_.Pop();
+                        current_move_ = PopBestMove(moves_);
+                        return;
+                    }
+                    current_step_ = GenerationStep::DistributeBadCaptures;
+                    /* Intentionally ommited break */
+
+                case GenerationStep::DistributeBadCaptures:
+                    if (bad_captures_.any())
+                    {
+                        current_move_ = PopBestMove(bad_captures_);
                         return;
                     }
                     current_step_ = GenerationStep::Done;
                     return;
-                    /* Intentionally ommited break */
 
                 case GenerationStep::OnlyDistributeMoves:
                     if (moves_.any())
@@ -234,13 +274,58 @@ namespace m8::movegen
                 #pragma GCC diagnostic pop
             }
 
+            /// Remove the move with the best score from a list and returns it.
+            inline static Move PopBestMove(MoveList& moves)
+            {
+                size_t indx_best = 0;
+                EvalType best_eval = moves[0].eval;
+                for (size_t x = 1; x < moves.size(); ++x)
+                {
+                    if (best_eval < moves[x].eval)
+                    {
+                        best_eval = moves[x].eval;
+                        indx_best = x;
+                    }
+                }
+                auto move = moves[indx_best].move;
+                moves.Erase(indx_best);
+                return move;
+            }
+
+            /// Indicate if a capture loses material. Captures of a piece at least as 
+            /// valuable as the capturing piece can't lose material, the static exchange
+            /// evaluation is only computed for the others.
+            inline bool IsLosingCapture(Move move) const
+            {
+                if (kSeeValues[GetPieceType(GetPiece(move))] <= kSeeValues[GetPieceType(GetPieceTaken(move))])
+                {
+                    return false;
+                }
+                return See(*(generator_->data_.board_), move) < 0;
+            }
+
+            /// Indicate if a killer move or a counter move can be played in the current
+            /// position. These moves come from other positions and might not even be 
+            /// legal. They are quiet moves so they can't be captures.
+            inline bool IsUsableQuietMove(Move move) const
+            {
+                return move != kNullMove
+                    && move != generator_->data_.tt_move_
+                    && IsPseudoLegal(*(generator_->data_.board_), move)
+                    && IsLegal(*(generator_->data_.board_), move);
+            }
+
             /// Enumerations of the differents steps of move generation
             enum class GenerationStep {
                 UseTranspositionMove,
                 GenerateCaptures,
-                DistributeCaptures,
+                DistributeGoodCaptures,
+                UseFirstKiller,
+                UseSecondKiller,
+                UseCounterMove,
                 GenerateQuietMoves,
-                DistributeRemainingMoves,
+                DistributeQuietMoves,
+                DistributeBadCaptures,
                 OnlyDistributeMoves,
                 Done
             };
@@ -248,19 +333,37 @@ namespace m8::movegen
             const MoveGenerator* generator_;
             GenerationStep current_step_;
             MoveList moves_;
+            MoveList bad_captures_;
             Move current_move_;
         };
 
         /// Constructor
         /// 
-        /// @param board   Position for which to generate moves.
-        /// @param tt_move Best move from the transposition table if one is available
+        /// @param board         Position for which to generate moves.
+        /// @param tt_move       Best move from the transposition table if one is available
+        /// @param move_ordering Tables used to order the quiet moves, if available.
+        /// @param distance      Distance of the position from the root of the search.
+        /// @param previous_move Move that lead to the position or kNullMove.
         inline MoveGenerator(Board& board,
-                             Move tt_move = kNullMove)
+                             Move tt_move = kNullMove,
+                             const MoveOrdering* move_ordering = nullptr,
+                             DepthType distance = 0,
+                             Move previous_move = kNullMove)
         {
             assert(!root);
             data_.board_ = &board;
             data_.tt_move_ = tt_move;
+            data_.move_ordering_ = move_ordering;
+            if (move_ordering != nullptr && !qsearch)
+            {
+                data_.killers_ = move_ordering->killers(distance);
+                data_.counter_move_ = move_ordering->counter_move(previous_move);
+            }
+            else
+            {
+                data_.killers_.fill(kNullMove);
+                data_.counter_move_ = kNullMove;
+            }
         }
 
         /// Constructor from a pre-generated list. Can be use at the root of the search to
@@ -293,6 +396,9 @@ namespace m8::movegen
             struct {
                 Board* board_;
                 Move tt_move_;
+                const MoveOrdering* move_ordering_;
+                KillerMoves killers_;
+                Move counter_move_;
             } data_;
             const MoveList* moves_;
         };
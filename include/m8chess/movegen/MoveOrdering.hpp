@@ -0,0 +1,142 @@
+/// @file MoveOrdering.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains the tables used to order the quiet moves: killer moves, history
+///        heuristic and counter moves.
+
+#ifndef M8_CHESS_MOVEGEN_MOVE_ORDERING_HPP_
+#define M8_CHESS_MOVEGEN_MOVE_ORDERING_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+#include "../Color.hpp"
+#include "../Move.hpp"
+#include "../Piece.hpp"
+#include "../Sq.hpp"
+#include "../Types.hpp"
+
+namespace m8::movegen
+{
+    /// Killer moves of a ply.
+    typedef std::array<Move, 2> KillerMoves;
+
+    /// Contains the informations gathered by the search to order the quiet moves.
+    /// Each search thread has it's own instance.
+    class MoveOrdering
+    {
+    public:
+        /// Maximum distance from the root for which killer moves are kept.
+        static const std::size_t kMaxDistance = 128;
+
+        /// Maximum absolute value of a history score. History scores are stored in the
+        /// eval field of a MoveEvalPair so they must fit in an EvalType.
+        static const int kMaxHistory = 16384;
+
+        /// Constructor
+        inline MoveOrdering()
+        {
+            Clear();
+        }
+
+        /// Clear all the tables.
+        inline void Clear()
+        {
+            for (auto& killers : killers_)
+            {
+                killers.fill(kNullMove);
+            }
+            for (auto& color_history : history_)
+            {
+                for (auto& from_history : color_history)
+                {
+                    from_history.fill(0);
+                }
+            }
+            for (auto& piece_counter_moves : counter_moves_)
+            {
+                piece_counter_moves.fill(kNullMove);
+            }
+        }
+
+        /// Returns the killer moves at a given distance from the root.
+        inline const KillerMoves& killers(DepthType distance) const
+        {
+            assert(static_cast<std::size_t>(distance) < kMaxDistance);
+            return killers_[distance];
+        }
+
+        /// Returns the history score of a quiet move.
+        inline EvalType history(Move move) const
+        {
+            return history_[GetColor(GetPiece(move))][GetFrom(move)][GetTo(move)];
+        }
+
+        /// Returns the move that refuted a given move the last time it was played or
+        /// kNullMove if there is none.
+        inline Move counter_move(Move previous_move) const
+        {
+            if (previous_move == kNullMove)
+            {
+                return kNullMove;
+            }
+            return counter_moves_[GetPiece(previous_move)][GetTo(previous_move)];
+        }
+
+        /// Update the tables after a quiet move caused a beta cutoff.
+        ///
+        /// @param move          Move that caused the cutoff.
+        /// @param previous_move Move played just before in the current line or kNullMove.
+        /// @param quiets_tried  Quiet moves searched before move that did not cause a
+        ///                      cutoff.
+        /// @param quiets_count  Number of moves in quiets_tried.
+        /// @param depth         Remaining depth of the node.
+        /// @param distance      Distance of the node from the root.
+        inline void OnQuietBetaCutoff(Move move,
+                                      Move previous_move,
+                                      const Move* quiets_tried,
+                                      std::size_t quiets_count,
+                                      DepthType depth,
+                                      DepthType distance)
+        {
+            assert(static_cast<std::size_t>(distance) < kMaxDistance);
+
+            auto& killers = killers_[distance];
+            if (killers[0] != move)
+            {
+                killers[1] = killers[0];
+                killers[0] = move;
+            }
+
+            if (previous_move != kNullMove)
+            {
+                counter_moves_[GetPiece(previous_move)][GetTo(previous_move)] = move;
+            }
+
+            int bonus = std::min(depth * depth, 400);
+            UpdateHistory(move, bonus);
+            for (std::size_t x = 0; x < quiets_count; ++x)
+            {
+                UpdateHistory(quiets_tried[x], -bonus);
+            }
+        }
+
+    private:
+        std::array<KillerMoves, kMaxDistance> killers_;
+        std::array<std::array<std::array<EvalType, kNumSqOnBoard>, kNumSqOnBoard>, 2> history_;
+        std::array<std::array<Move, kNumSqOnBoard>, kMaxPiece + 1> counter_moves_;
+
+        /// Update the history score of a move. The score is moved toward the bonus with
+        /// a gravity term that keep it in [-kMaxHistory, kMaxHistory] and let recent
+        /// results weight more than older ones.
+        inline void UpdateHistory(Move move, int bonus)
+        {
+            EvalType& entry = history_[GetColor(GetPiece(move))][GetFrom(move)][GetTo(move)];
+            entry += bonus - entry * std::abs(bonus) / kMaxHistory;
+        }
+    };
+}
+
+#endif // M8_CHESS_MOVEGEN_MOVE_ORDERING_HPP_
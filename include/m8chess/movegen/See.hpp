@@ -0,0 +1,155 @@
+/// @file See.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains the static exchange evaluation (SEE) of moves.
+
+#ifndef M8_CHESS_MOVEGEN_SEE_HPP_
+#define M8_CHESS_MOVEGEN_SEE_HPP_
+
+#include <algorithm>
+#include <array>
+
+#include "../../m8common/Bb.hpp"
+
+#include "../Board.hpp"
+#include "../Move.hpp"
+#include "../Piece.hpp"
+#include "../Sq.hpp"
+#include "../XRay.hpp"
+
+#include "MoveGeneration.hpp"
+
+namespace m8::movegen
+{
+    /// Values of the pieces used by the static exchange evaluation, indexed by piece
+    /// type. The SEE use it's own fixed values so that the ordering of the captures
+    /// does not change when the evaluation is tuned.
+    const std::array<int, kMaxPieceType + 1> kSeeValues = 
+    {
+        0,     // kNoPieceType
+        100,   // kPawn
+        325,   // kKnight
+        20000, // kKing
+        975,   // kQueen
+        325,   // kBishop
+        500    // kRook
+    };
+
+    /// Piece types ordered from the least to the most valuable.
+    const std::array<PieceType, 6> kPieceTypesByValue = { kPawn, kKnight, kBishop, kRook, kQueen, kKing };
+
+    /// Find the least valuable piece of a given color in a set of attackers.
+    ///
+    /// @param board     Position on which the exchange take place.
+    /// @param attackers Bitboard of the attackers.
+    /// @param color     Color of the attacker we look for.
+    /// @param sq        Receive the position of the least valuable attacker.
+    /// @return The type of the least valuable attacker or kNoPieceType if there is no
+    ///         attacker of the given color.
+    inline PieceType GetLeastValuableAttacker(const Board& board, Bb attackers, Color color, Sq& sq)
+    {
+        for (PieceType piece_type : kPieceTypesByValue)
+        {
+            Bb bb = attackers & board.bb_piece(NewPiece(piece_type, color));
+            if (bb != kEmptyBb)
+            {
+                sq = GetLsb(bb);
+                return piece_type;
+            }
+        }
+
+        return kNoPieceType;
+    }
+
+    /// Compute the static exchange evaluation of a move. The SEE is the material balance
+    /// after all the captures on the destination square of the move, assuming that each
+    /// side always capture with it's least valuable piece and can stop capturing when
+    /// it's not favorable.
+    ///
+    /// Sliders behind the pieces that take part in the exchange are revealed using
+    /// the x-ray attacks.
+    ///
+    /// @param board Position before the move is made.
+    /// @param move  Move to evaluate.
+    /// @return The material won (positive) or lost (negative) by the side making the
+    ///         move.
+    inline int See(const Board& board, Move move)
+    {
+        Sq from = GetFrom(move);
+        Sq to = GetTo(move);
+        Piece piece = GetPiece(move);
+        Piece taken = GetPieceTaken(move);
+        Piece promote_to = GetPromoteTo(move);
+        Color side = GetColor(piece);
+
+        Bb occ = board.bb_occupied();
+        Bb diagonal_sliders = board.bb_piece(kWhiteBishop) | board.bb_piece(kBlackBishop)
+                            | board.bb_piece(kWhiteQueen)  | board.bb_piece(kBlackQueen);
+        Bb straight_sliders = board.bb_piece(kWhiteRook)   | board.bb_piece(kBlackRook)
+                            | board.bb_piece(kWhiteQueen)  | board.bb_piece(kBlackQueen);
+
+        // An en passant capture remove a pawn that is not on the destination square. 
+        // A rook or queen behind this pawn might now attack the destination square.
+        Bb attackers = AttacksTo(board, to);
+        if (IsPiece(taken) && board[to] == kNoPiece)
+        {
+            occ ^= GetSingleBitBb(NewSq(GetColmn(to), GetRow(from)));
+            attackers |= GenerateRookAttacks(occ, to) & straight_sliders;
+        }
+
+        std::array<int, 32> gains;
+        int index = 0;
+
+        gains[0] = kSeeValues[GetPieceType(taken)];
+        int value_on_sq = kSeeValues[GetPieceType(piece)];
+        if (IsPiece(promote_to))
+        {
+            gains[0] += kSeeValues[GetPieceType(promote_to)] - kSeeValues[kPawn];
+            value_on_sq = kSeeValues[GetPieceType(promote_to)];
+        }
+
+        Bb bb_from = GetSingleBitBb(from);
+        while (true)
+        {
+            // The piece that just captured is removed from the occupancy. The sliders
+            // behind it are now attacking the destination square.
+            attackers |= (GenerateBishopXRay(occ, bb_from, to) & diagonal_sliders)
+                       | (GenerateRookXRay(occ, bb_from, to) & straight_sliders);
+            occ ^= bb_from;
+            attackers &= occ;
+
+            side = OpposColor(side);
+            Sq attacker_sq;
+            PieceType attacker_type = GetLeastValuableAttacker(board, attackers, side, attacker_sq);
+            if (attacker_type == kNoPieceType || index + 1 == static_cast<int>(gains.size()))
+            {
+                break;
+            }
+
+            ++index;
+            gains[index] = value_on_sq - gains[index - 1];
+
+            // If the side to move can't improve it's result by continuing the exchange
+            // we can stop. The other side would stop capturing.
+            if (std::max(-gains[index - 1], gains[index]) < 0)
+            {
+                break;
+            }
+
+            value_on_sq = kSeeValues[attacker_type];
+            bb_from = GetSingleBitBb(attacker_sq);
+        }
+
+        // Each side can decide to stop the exchange if it's not favorable.
+        while (0 < index)
+        {
+            gains[index - 1] = -std::max(-gains[index - 1], gains[index]);
+            --index;
+        }
+
+        return gains[0];
+    }
+}
+
+#endif // M8_CHESS_MOVEGEN_SEE_HPP_
@@ -7,11 +7,13 @@
 #ifndef M8_ALPHA_BETA_HPP_
 #define M8_ALPHA_BETA_HPP_
 
+#include <array>
 #include <vector>
 #include <chrono>
 
 #include "m8chess/TimeManager.hpp"
 
+#include "../movegen/MoveOrdering.hpp"
 #include "../transposition/TranspositionTable.hpp"
 
 #include "../Board.hpp"
@@ -27,6 +29,16 @@
 namespace m8 {
     namespace search
     {
+        /// Type of a node in the search tree. PV nodes are searched with an open
+        /// window and collect the principal variation. Non-PV nodes are searched with a
+        /// null window and are expected to fail high or low.
+        enum class NodeType
+        {
+            Root,
+            PV,
+            NonPV
+        };
+
         /// Manage the seach for the engine.
         class AlphaBeta : public SearchSubject<PV, Move>
         {
@@ -37,11 +49,45 @@ namespace m8 {
                       const MoveList& root_moves);
 
             /// Start a search on a given position.
-            SearchResult Start(DepthType depth);
+            ///
+            /// @param depth Depth of the search.
+            /// @param alpha Lower bound of the search window.
+            /// @param beta  Upper bound of the search window.
+            /// @returns The result of the search. The search is fail-soft, if the value
+            ///          is outside of the window it is only a bound on the real value.
+            SearchResult Start(DepthType depth,
+                               EvalType alpha = eval::kMinEval,
+                               EvalType beta = eval::kMaxEval);
 
         private:
             const NodeCounterType kNodesBeforeFirstCheck = 100000;
 
+            /// Maximum distance from the root of a node of the main search.
+            static const std::size_t kMaxDistance = MAX_PV_SIZE;
+
+            /// Minimum depth at which we try a null move.
+            const DepthType kNullMoveMinDepth = 2;
+
+            /// Base reduction of a null move search. The reduction is increased by one 
+            /// every kNullMoveReductionDepthDivisor plies of depth.
+            const DepthType kNullMoveBaseReduction = 2;
+            const DepthType kNullMoveReductionDepthDivisor = 6;
+
+            /// Minimum depth at which a null move cutoff is verified by a reduced search
+            /// without null move.
+            const DepthType kNullMoveVerificationDepth = 12;
+
+            /// Maximum number of quiet moves that are penalized in the history table
+            /// when another quiet move causes a beta cutoff.
+            static const std::size_t kMaxQuietsTried = 64;
+
+            /// Margin used by the delta pruning in the qsearch.
+            const EvalType kDeltaPruningMargin = 200;
+
+            /// Size of each dimension of the late move reductions table. Greater depths
+            /// and move numbers use the last entry.
+            static const std::size_t kLmrTableSize = 64;
+
             Board board_;
             const MoveList& root_moves_;
             bool continue_;
@@ -50,8 +96,47 @@ namespace m8 {
             std::shared_ptr<Search> search_;
             transposition::TranspositionTable& transposition_table_;
 
-            template<bool root, bool qsearch>
+            /// Move played at each distance from the root in the current line. A null
+            /// move is represented by kNullMove.
+            std::array<Move, kMaxDistance> moves_stack_;
+
+            /// Null moves are not allowed in nodes closer to the root than this 
+            /// distance. This is used to disable null moves during a verification search.
+            DepthType null_move_min_distance_;
+
+            /// Killer moves, history and counter moves tables used to order the quiet 
+            /// moves.
+            movegen::MoveOrdering move_ordering_;
+
+            /// Base late move reduction indexed by [depth][move_number]. The table and 
+            /// the other parameters of the reductions are read from the options when the
+            /// search is created.
+            std::array<std::array<DepthType, kLmrTableSize>, kLmrTableSize> lmr_table_;
+            DepthType lmr_min_depth_;
+            std::uint16_t lmr_full_depth_moves_;
+            int lmr_history_divisor_;
+
+            /// Initialize the late move reductions table from the options.
+            void InitializeLmrTable();
+
+            /// Returns the reduction of a late move.
+            inline DepthType GetLateMoveReduction(DepthType depth, std::uint16_t move_number) const
+            {
+                return lmr_table_[std::min<std::size_t>(depth, kLmrTableSize - 1)]
+                                 [std::min<std::size_t>(move_number, kLmrTableSize - 1)];
+            }
+
+            template<NodeType node_type, bool qsearch>
             EvalType AlphaBetaSearch(EvalType alpha, EvalType beta, DepthType depth, DepthType distance, PV& pv);
+
+            /// Search a child node. The child node is searched by the quiescence search 
+            /// if the remaining depth is zero or less.
+            template<NodeType node_type>
+            inline EvalType SearchChild(EvalType alpha, EvalType beta, DepthType depth, DepthType distance, PV& pv)
+            {
+                return 0 < depth ? AlphaBetaSearch<node_type, false>(alpha, beta, depth, distance, pv)
+                                 : AlphaBetaSearch<NodeType::NonPV, true>(alpha, beta, 0, distance, pv);
+            }
         };
 
     }
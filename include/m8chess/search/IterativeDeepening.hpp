@@ -6,6 +6,10 @@
 #ifndef M8_CHESS_SEARCH_ITERATIVE_DEEPENING_HPP_
 #define M8_CHESS_SEARCH_ITERATIVE_DEEPENING_HPP_
 
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "../TimeManager.hpp"
 
 #include "../transposition/TranspositionTable.hpp"
@@ -16,10 +20,26 @@
 #include "AlphaBeta.hpp"
 #include "Search.hpp"
 #include "SearchResult.hpp"
+#include "SearchStats.hpp"
 #include "SearchSubject.hpp"
 
 namespace m8::search {
 
+    /// Helper thread of a Lazy SMP search. Each helper runs it's own iterative 
+    /// deepening loop on a private copy of the board and only communicate with the 
+    /// other threads through the shared transposition table.
+    struct SearchHelper
+    {
+        /// Private search object of the helper. Aborting it stops the helper.
+        std::shared_ptr<Search> search;
+
+        /// Statistics of the helper search.
+        SearchStats stats;
+
+        /// Thread running the helper.
+        std::thread thread;
+    };
+
     class IterativeDeepening : public SearchSubject<PV, Move>, public ISearchObserver<PV, Move>
     {
     public:
@@ -36,9 +56,24 @@ namespace m8::search {
         void OnNewBestMove(const PV& pv, EvalType eval, DepthType depth, double time, NodeCounterType nodes);
     
     private:
+        /// Half width of the initial aspiration window.
+        const EvalType kAspirationWindow = 25;
+
+        /// Minimum depth at which the aspiration windows are used.
+        const DepthType kAspirationMinDepth = 4;
+
         transposition::TranspositionTable& transposition_table_;
 
         void GetRootMoves(Board board, MoveList& move_list);
+
+        /// Search an iteration using an aspiration window centered on the value of the
+        /// previous iteration. The window is widened each time the search fails low or
+        /// high until the value is inside the window or the search is aborted.
+        SearchResult AspirationSearch(AlphaBeta& alpha_beta, MoveList& root_moves, DepthType depth, const SearchResult& previous_result);
+
+        std::vector<std::unique_ptr<SearchHelper>> StartHelpers(std::shared_ptr<Search> search, const MoveList& root_moves);
+        SearchStats StopHelpers(std::vector<std::unique_ptr<SearchHelper>>& helpers);
+        void RunHelper(SearchHelper& helper, MoveList root_moves, std::size_t index);
     };
 }
 
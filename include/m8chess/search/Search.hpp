@@ -6,6 +6,7 @@
 #ifndef M8_SEARCH_SEARCH_HPP_
 #define M8_SEARCH_SEARCH_HPP_
 
+#include <atomic>
 #include <memory>
 
 #include "../TimeManager.hpp"
@@ -42,17 +43,17 @@ namespace m8::search
         /// Returns the maximum depth for the search.
         inline DepthType max_depth() const { return max_depth_; }
 
-        /// Indicate if the search is aborted
-        inline bool is_aborted() const { return is_aborted_; }
+        /// Indicate if the search is aborted. This can be called from any thread.
+        inline bool is_aborted() const { return is_aborted_.load(std::memory_order_relaxed); }
 
-        /// Abort the search
-        inline void Abort() { is_aborted_ = true; }
+        /// Abort the search. This can be called from any thread.
+        inline void Abort() { is_aborted_.store(true, std::memory_order_relaxed); }
         
     private:
         Board board_;
         std::unique_ptr<TimeManager> time_manager_;
         DepthType max_depth_;
-        bool is_aborted_;
+        std::atomic<bool> is_aborted_;
     };
 }
 
@@ -47,6 +47,20 @@ namespace m8::search
         
         /// Returns the sum of all nodes.
         inline NodeCounterType all_nodes() const { return nodes + qnodes; };
+
+        /// Add the statistics of another search to this one. This is used to merge the
+        /// statistics of all the threads of a parallel search.
+        inline SearchStats& operator+=(const SearchStats& rhs)
+        {
+            nodes         += rhs.nodes;
+            qnodes        += rhs.qnodes;
+            tt_probes     += rhs.tt_probes;
+            tt_hits       += rhs.tt_hits;
+            tt_hits_exact += rhs.tt_hits_exact;
+            tt_hits_upper += rhs.tt_hits_upper;
+            tt_hits_lower += rhs.tt_hits_lower;
+            return *this;
+        }
     };
 }
 
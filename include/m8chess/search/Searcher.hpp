@@ -82,7 +82,7 @@ namespace m8::search
 
     private:
         bool destroying_; // Indicate if the object is being destroyed (to stop threads).
-        std::thread search_thread_;
+        bool search_pending_; // Indicate if a search was started and not yet picked up by the search thread.
         std::condition_variable condition_variable_;
         std::mutex mutex_;
         
@@ -94,6 +94,10 @@ namespace m8::search
 
         std::chrono::steady_clock::time_point start_time_;
 
+        // The search thread is declared last so that it is started only once all the
+        // other members are initialized.
+        std::thread search_thread_;
+
         double GetSearchTime() const;
         void RunSearchThread();
         bool StopSearch();
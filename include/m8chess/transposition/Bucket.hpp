@@ -6,28 +6,63 @@
 #ifndef M8_TRANSPOSITION_BUCKET_HPP_
 #define M8_TRANSPOSITION_BUCKET_HPP_
 
+#include <array>
+#include <bit>
+#include <limits>
+#include <optional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define M8_BUCKET_USE_SSE2
+#endif
+
 #include "TranspositionEntry.hpp"
 
 namespace m8::transposition
 {
     /// Represent a bucket in the transposition table.
+    ///
+    /// The bucket fills a cache line with 8 entries of 8 bytes. Each field of the entries
+    /// is stored in its own array so that the keys of all the entries can be compared
+    /// at once. Only 16 bits of the hash key are stored. The other bits are given by the
+    /// index of the bucket in the table, which is computed from the most significant bits
+    /// of the key.
+    ///
+    /// The bucket is shared by all the threads of the search without locks. The key
+    /// stored is xored with the data of the entry, so an entry partially overwritten by
+    /// another thread won't match the key.
     class alignas(64) Bucket
     {
     public:
         /// Get from the bucket the transposition table entry corresponding to the hash
         /// key.
-        /// 
+        ///
         /// @param key Hash key of the position
-        /// @return A pointer to the position or nullptr if no entries in the bucket 
-        ///         correspond to the position.
-        inline TranspositionEntry* operator[](ZobristKey key)
+        /// @return A copy of the entry or nothing if no entries in the bucket correspond
+        ///         to the position.
+        inline std::optional<TranspositionEntry> operator[](ZobristKey key) const
         {
-            auto entry = std::find_if(entries_.begin(), entries_.end(), [key](const TranspositionEntry entry) {return entry.key() == key; });
-            return entry != entries_.end() ? entry : nullptr;
+            auto fragment = GetKeyFragment(key);
+            auto index = GetFirstIndex(FindEntries(fragment));
+            if (index == kNumberOfEntries)
+            {
+                return std::nullopt;
+            }
+
+            // The entry might be overwritten since it was found. We work on a copy and
+            // check it again.
+            std::uint16_t stored_key = keys_[index];
+            TranspositionEntry entry(moves_[index], evals_[index], infos_[index]);
+            if (!IsEntryOf(stored_key, entry, fragment))
+            {
+                return std::nullopt;
+            }
+
+            return entry;
         }
 
         /// Store a new position in the bucket
-        /// 
+        ///
         /// @param key        Hash key for the position
         /// @param move       Best move in the position
         /// @param generation Current generation of the search. This can be used to prefer
@@ -39,31 +74,131 @@ namespace m8::transposition
         /// @param eval       Evaluation of the position
         inline void Insert(ZobristKey key, Move move, std::uint8_t generation, EntryType type, DepthType depth, DepthType distance, EvalType eval)
         {
-            auto entry = std::min_element(std::begin(entries_),
-                                          std::end(entries_),
-                                          [generation, key](const TranspositionEntry& lhs, const TranspositionEntry rhs)
-                                          {
-                                          // Returns true if lhs is a better candidate than rhs to store the new position.
-                                          return lhs.key() == key ||
-                                                 (
-                                                    rhs.key() != key &&
-                                                    (    
-                                                        lhs.GetAge(generation) > rhs.GetAge(generation) ||
-                                                        (
-                                                            lhs.GetAge(generation) == rhs.GetAge(generation) &&
-                                                            lhs.depth() < rhs.depth()
-                                                        )
-                                                    )
-                                                 );                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                     
-                                          });
-            *entry = TranspositionEntry(key, move, generation, type, depth, distance, eval);
+            auto fragment = GetKeyFragment(key);
+            auto victim = FindVictim(fragment, generation);
+
+            TranspositionEntry entry(move, generation, type, depth, distance, eval);
+            moves_[victim] = entry.compact_move();
+            evals_[victim] = entry.eval();
+            infos_[victim] = entry.info();
+            keys_[victim] = static_cast<std::uint16_t>(fragment ^ entry.compact_move() ^ entry.eval() ^ entry.info());
         }
-        
+
     private:
-        static const std::size_t kNumberOfEntries = 4;
+        static const std::size_t kNumberOfEntries = 8;
+
+        std::array<std::uint16_t, kNumberOfEntries> keys_;
+        std::array<CompactMove, kNumberOfEntries> moves_;
+        std::array<std::uint16_t, kNumberOfEntries> evals_;
+        std::array<std::uint16_t, kNumberOfEntries> infos_;
+
+        /// Returns the bits of the key stored in the bucket. They must not be used to
+        /// compute the index of the bucket.
+        static inline std::uint16_t GetKeyFragment(ZobristKey key)
+        {
+            return static_cast<std::uint16_t>(key);
+        }
+
+        /// Returns true if an entry contains the position of a key fragment. The info of
+        /// an entry is never 0, this way the empty entries never match.
+        static inline bool IsEntryOf(std::uint16_t stored_key, const TranspositionEntry& entry, std::uint16_t fragment)
+        {
+            return entry.info() != 0
+                && (stored_key ^ entry.compact_move() ^ entry.eval() ^ entry.info()) == fragment;
+        }
+
+        /// Returns the index of the first entry of a mask returned by FindEntries or
+        /// kNumberOfEntries if the mask is empty.
+        static inline std::size_t GetFirstIndex(std::uint32_t mask)
+        {
+            // There are two bits in the mask for each entry.
+            return mask ? std::countr_zero(mask) / 2 : kNumberOfEntries;
+        }
 
-        std::array<TranspositionEntry, kNumberOfEntries> entries_;
+#if defined(M8_BUCKET_USE_SSE2)
+        /// Compare the keys of all the entries with a key fragment.
+        ///
+        /// @return A vector with all the bits of the matching entries set to 1.
+        inline __m128i MatchEntries(std::uint16_t fragment) const
+        {
+            auto keys  = _mm_load_si128(reinterpret_cast<const __m128i*>(keys_.data()));
+            auto moves = _mm_load_si128(reinterpret_cast<const __m128i*>(moves_.data()));
+            auto evals = _mm_load_si128(reinterpret_cast<const __m128i*>(evals_.data()));
+            auto infos = _mm_load_si128(reinterpret_cast<const __m128i*>(infos_.data()));
+
+            auto stored = _mm_xor_si128(_mm_xor_si128(keys, moves), _mm_xor_si128(evals, infos));
+            return _mm_andnot_si128(_mm_cmpeq_epi16(infos, _mm_setzero_si128()),
+                                    _mm_cmpeq_epi16(stored, _mm_set1_epi16(static_cast<short>(fragment))));
+        }
+#endif
+
+        /// Find the entries of a key fragment.
+        ///
+        /// @return A mask with the bits 2i and 2i+1 set if the entry i matches.
+        inline std::uint32_t FindEntries(std::uint16_t fragment) const
+        {
+#if defined(M8_BUCKET_USE_SSE2)
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(MatchEntries(fragment)));
+#else
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < kNumberOfEntries; ++i)
+            {
+                TranspositionEntry entry(moves_[i], evals_[i], infos_[i]);
+                mask |= static_cast<std::uint32_t>(IsEntryOf(keys_[i], entry, fragment)) * (3u << (2 * i));
+            }
+            return mask;
+#endif
+        }
+
+        /// Find the entry to replace with a new entry. This is the entry of the same
+        /// position if there is one. Otherwise it is the oldest entry, and the shallowest
+        /// one among the oldest entries.
+        inline std::size_t FindVictim(std::uint16_t fragment, std::uint8_t generation) const
+        {
+            // The cost of replacing each entry is computed without branches and the
+            // cheapest entry is replaced. The entry of the same position costs 0.
+            constexpr std::uint16_t kDepthMask = (1u << TranspositionEntry::kDepthSize) - 1;
+
+#if defined(M8_BUCKET_USE_SSE2)
+            auto infos = _mm_load_si128(reinterpret_cast<const __m128i*>(infos_.data()));
+            auto generations = _mm_srli_epi16(infos, TranspositionEntry::kGenerationPos);
+            auto ages = _mm_and_si128(_mm_sub_epi16(_mm_set1_epi16(generation), generations),
+                                      _mm_set1_epi16(TranspositionEntry::kGenerationMask));
+            auto youth = _mm_sub_epi16(_mm_set1_epi16(TranspositionEntry::kGenerationMask), ages);
+            auto costs = _mm_or_si128(_mm_slli_epi16(youth, TranspositionEntry::kDepthSize),
+                                      _mm_and_si128(infos, _mm_set1_epi16(kDepthMask)));
+            costs = _mm_andnot_si128(MatchEntries(fragment), _mm_add_epi16(costs, _mm_set1_epi16(1)));
+
+            // The costs are less than 2^14 so they can be compared as signed integers.
+            auto min = _mm_min_epi16(costs, _mm_shuffle_epi32(costs, _MM_SHUFFLE(1, 0, 3, 2)));
+            min = _mm_min_epi16(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1)));
+            min = _mm_min_epi16(min, _mm_shufflelo_epi16(_mm_shufflehi_epi16(min, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1)));
+
+            return GetFirstIndex(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(costs, min))));
+#else
+            auto matches = FindEntries(fragment);
+
+            std::size_t victim = 0;
+            std::uint32_t victim_cost = (std::numeric_limits<std::uint32_t>::max)();
+            for (std::size_t i = 0; i < kNumberOfEntries; ++i)
+            {
+                std::uint32_t youth = TranspositionEntry::kGenerationMask - TranspositionEntry::GetAge(infos_[i], generation);
+                std::uint32_t cost = (youth << TranspositionEntry::kDepthSize | (infos_[i] & kDepthMask)) + 1;
+                cost *= !((matches >> (2 * i)) & 1);
+
+                bool cheaper = cost < victim_cost;
+                victim = cheaper ? i : victim;
+                victim_cost = cheaper ? cost : victim_cost;
+            }
+            return victim;
+#endif
+        }
     };
+
+    // The keys and the moves are compared and loaded as arrays of 16 bits values and
+    // the bucket must fill exactly one cache line.
+    static_assert(sizeof(CompactMove) == 2);
+    static_assert(sizeof(Bucket) == 64);
 }
 
-#endif // M8_TRANSPOSITION_BUCKET_HPP_
\ No newline at end of file
+#endif // M8_TRANSPOSITION_BUCKET_HPP_
@@ -10,6 +10,7 @@
 
 #include "../eval/Eval.hpp"
 
+#include "../CompactMove.hpp"
 #include "../Move.hpp"
 #include "../Types.hpp"
 
@@ -18,7 +19,9 @@
 
 namespace m8::transposition
 {
-    /// Represents an entry in the transposition table
+    /// Represents an entry in the transposition table. The entries are stored compactly
+    /// in the buckets: a 16 bits move, a 16 bits evaluation and 16 bits containing the
+    /// depth, the type and the generation.
     class TranspositionEntry
     {
     public:
@@ -27,85 +30,96 @@ namespace m8::transposition
 
         /// Constructor
         /// 
-        /// @param key        Hash key for the position
         /// @param move       Best move in the position
         /// @param generation Generation of the entry. This can be used to 
         ///                   prefer recent entries when deciding how to overwrite.
+        ///                   Only the 6 least significant bits are kept.
         /// @param type       Type of evaluation in the entry (exact, lower
         ///                   bound, upper bound)
         /// @param depth      Depth of the search used to get the evaluation
+        /// @param distance   Distance from the root of the search
         /// @param eval       Evaluation of the position
-        inline TranspositionEntry(ZobristKey key, Move move, std::uint8_t generation, EntryType type, DepthType depth, DepthType distance, EvalType eval)
+        inline TranspositionEntry(Move move, std::uint8_t generation, EntryType type, DepthType depth, DepthType distance, EvalType eval)
         {
             eval = eval::RemoveDistanceFromMate(eval, distance);
-            std::uint64_t unsigned_eval = static_cast<std::int64_t>(eval) + (INT64_C(1) << (kEvalSize - 1));
 
-            assert(static_cast<std::uint64_t>(move)          < (UINT64_C(1) << kMoveSize));
-            assert(static_cast<std::uint64_t>(generation)    < (UINT64_C(1) << kGenerationSize));
-            assert(static_cast<std::uint64_t>(type)          < (UINT64_C(1) << kTypeSize));
-            assert(static_cast<std::uint64_t>(depth)         < (UINT64_C(1) << kDepthSize));
-            assert(static_cast<std::uint64_t>(unsigned_eval) < (UINT64_C(1) << kEvalSize));
+            assert(0 <= depth);
+            depth = (std::min)(depth, static_cast<DepthType>((1 << kDepthSize) - 1));
 
-            data_ = (static_cast<std::uint64_t>(move)          << kMovePos)
-                  | (static_cast<std::uint64_t>(generation)    << kGenerationPos)
-                  | (static_cast<std::uint64_t>(type)          << kTypePos)
-                  | (static_cast<std::uint64_t>(depth)         << kDepthPos)
-                  | (static_cast<std::uint64_t>(unsigned_eval) << kEvalPos);
-
-            key_ = key ^ data_; // For lock-less hash table, xor the data and the key.
+            move_ = ToCompactMove(move);
+            eval_ = static_cast<std::uint16_t>(eval);
+            info_ = static_cast<std::uint16_t>((depth                          << kDepthPos)
+                                             | (static_cast<int>(type)         << kTypePos)
+                                             | ((generation & kGenerationMask) << kGenerationPos));
         }
 
-        /// Returns the hash key for the position
-        inline ZobristKey key() const { return key_ ^ data_; }
+        /// Constructor from the fields stored in a bucket.
+        inline TranspositionEntry(CompactMove move, std::uint16_t eval, std::uint16_t info)
+        : move_(move),
+          eval_(eval),
+          info_(info)
+        {}
+
+        /// Returns the move. The move is decoded in the position of the entry and must
+        /// still be validated, as it can come from another position in case of a
+        /// collision.
+        inline Move GetMove(const Board& board) const { return FromCompactMove(move_, board); }
 
-        /// Returns the move.
-        inline Move move() const { return (data_ & kMoveMask) >> kMovePos; }
+        /// Returns the move encoded on 16 bits.
+        inline CompactMove compact_move() const { return move_; }
 
         /// Returns the generation
-        inline std::uint8_t generation() const { return (data_ & kGenerationMask) >> kGenerationPos; }
+        inline std::uint8_t generation() const { return static_cast<std::uint8_t>(info_ >> kGenerationPos); }
 
         /// Returns the type
-        inline EntryType type() const { return static_cast<EntryType>((data_ & kTypeMask) >> kTypePos); }
+        inline EntryType type() const { return static_cast<EntryType>((info_ >> kTypePos) & ((1u << kTypeSize) - 1)); }
 
         /// Returns the depth
-        inline DepthType depth() const { return (data_ & kDepthMask) >> kDepthPos; }
+        inline DepthType depth() const { return static_cast<DepthType>((info_ >> kDepthPos) & ((1u << kDepthSize) - 1)); }
 
         /// Returns the evaluation
         inline EvalType GetEval(DepthType distance) const
         {
-            EvalType eval = static_cast<std::int64_t>((data_ & kEvalMask) >> kEvalPos) - (INT64_C(1) << (kEvalSize - 1));
-            return eval::AddDistanceToMate(eval, distance);
+            return eval::AddDistanceToMate(static_cast<EvalType>(eval_), distance);
         }
 
-        /// Calculate the age of the entry based on the current generation.é
+        /// Calculate the age of the entry based on the current generation.
         inline std::uint8_t GetAge(std::uint8_t current_generation) const
         {
-            return current_generation - generation();
+            return GetAge(info_, current_generation);
+        }
+
+        /// Calculate the age of an entry from its packed informations.
+        static inline std::uint8_t GetAge(std::uint16_t info, std::uint8_t current_generation)
+        {
+            return (current_generation - (info >> kGenerationPos)) & kGenerationMask;
         }
-        
+
+        /// Returns the packed evaluation.
+        inline std::uint16_t eval() const { return eval_; }
+
+        /// Returns the packed depth, type and generation. It is never 0 for a valid
+        /// entry because the type is never 0.
+        inline std::uint16_t info() const { return info_; }
+
+        /// Size of the depth in the packed informations. Deeper searches are stored with
+        /// the maximum depth.
+        static const std::uint16_t kDepthSize      = 8;
+        static const std::uint16_t kTypeSize       = 2;
+        static const std::uint16_t kGenerationSize = 6;
+
+        static const std::uint16_t kDepthPos      = 0;
+        static const std::uint16_t kTypePos       = kDepthPos + kDepthSize;
+        static const std::uint16_t kGenerationPos = kTypePos  + kTypeSize;
+
+        static const std::uint8_t kGenerationMask = (1u << kGenerationSize) - 1;
+
     private:
-        static const std::uint64_t kMoveSize       = 26;
-        static const std::uint64_t kGenerationSize = 8;
-        static const std::uint64_t kTypeSize       = 2;
-        static const std::uint64_t kDepthSize      = 12;
-        static const std::uint64_t kEvalSize       = 16;
-
-        static const std::uint64_t kMovePos       = 0;
-        static const std::uint64_t kGenerationPos = kMovePos       + kMoveSize;
-        static const std::uint64_t kTypePos       = kGenerationPos + kGenerationSize;
-        static const std::uint64_t kDepthPos      = kTypePos       + kTypeSize;
-        static const std::uint64_t kEvalPos       = kDepthPos      + kDepthSize;
-
-        static const std::uint64_t kMoveMask       = CalculateMask(kMovePos, kMoveSize);
-        static const std::uint64_t kGenerationMask = CalculateMask(kGenerationPos, kGenerationSize);
-        static const std::uint64_t kTypeMask       = CalculateMask(kTypePos, kTypeSize);
-        static const std::uint64_t kDepthMask      = CalculateMask(kDepthPos, kDepthSize);
-        static const std::uint64_t kEvalMask       = CalculateMask(kEvalPos, kEvalSize);
-
-        ZobristKey    key_;
-        std::uint64_t data_;
+        CompactMove   move_;
+        std::uint16_t eval_;
+        std::uint16_t info_;
     };
     
 }
 
-#endif // M8_TRANSPOSITION_TRANSPOSITION_ENTRY_HPP_
\ No newline at end of file
+#endif // M8_TRANSPOSITION_TRANSPOSITION_ENTRY_HPP_
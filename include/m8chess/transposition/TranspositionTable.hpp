@@ -9,9 +9,17 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <new>
+#include <optional>
+#include <thread>
 #include <vector>
 
-#include "../../m8common/Bb.hpp"
+#if defined(_MSC_VER)
+#   include <xmmintrin.h>
+#endif
+
+#include "../../m8common/LargePages.hpp"
+#include "../../m8common/Utils.hpp"
 
 #include "Bucket.hpp"
 
@@ -26,7 +34,6 @@ namespace m8::transposition
           buckets_count_(0),
           generation_(0)
         {
-            assert(64 == sizeof(Bucket));
             assert(1024 <= size);
 
             Resize(size);
@@ -34,10 +41,7 @@ namespace m8::transposition
 
         inline ~TranspositionTable()
         {
-            if (data_ != nullptr)
-            {
-                std::free(data_);
-            }
+            FreeLargePages(allocation_);
         }
 
         /// Increment the current generation. This need to be call once between each
@@ -45,15 +49,27 @@ namespace m8::transposition
         /// differentiate entry from the current search from entry of previous search.
         inline void IncrementGeneration() { ++generation_; }
 
-        /// Returns a pointer to the entry in the transposition table corresponding to the
+        /// Returns a copy of the entry in the transposition table corresponding to the
         /// key passed in parameters. If there is no information stored for the current
-        /// position a null pointer is retured.
-        inline TranspositionEntry* operator[](ZobristKey key)
+        /// position nothing is retured.
+        inline std::optional<TranspositionEntry> operator[](ZobristKey key) const
         {
-            auto& bucket = data_[key & mask_];
+            auto& bucket = data_[GetBucketIndex(key)];
             return bucket[key];
         }
 
+        /// Start loading the bucket of a key in the cache. The table is much larger than
+        /// the cache, so the bucket is prefetched as soon as the key of a position is
+        /// known to hide the latency of the memory access.
+        inline void Prefetch(ZobristKey key) const
+        {
+#if defined(_MSC_VER)
+            _mm_prefetch(reinterpret_cast<const char*>(&data_[GetBucketIndex(key)]), _MM_HINT_T0);
+#else
+            __builtin_prefetch(&data_[GetBucketIndex(key)]);
+#endif
+        }
+
         /// Insert an entry in the transposition table.
         /// 
         /// @param key        Hash key for the position
@@ -67,12 +83,17 @@ namespace m8::transposition
         /// @param eval       Evaluation of the position
         inline void Insert(ZobristKey key, Move move, EntryType type, DepthType depth, DepthType distance, EvalType eval)
         {
-            auto& bucket = data_[key & mask_];
+            auto& bucket = data_[GetBucketIndex(key)];
             bucket.Insert(key, move, generation_, type, depth, distance, eval);
         }
 
         /// Resize the hash table.
         ///
+        /// If the memory can't be allocated, the table is allocated again with its
+        /// previous size, or with the minimum size, so that it stays usable and
+        /// std::bad_alloc is thrown. The table is only left empty if even the minimum
+        /// size can't be allocated.
+        ///
         /// @param size Size of the hash table in bytes.
         inline void Resize(size_t size)
         {
@@ -81,17 +102,41 @@ namespace m8::transposition
             auto new_count = CalculateNumberEntry(size);
             if (new_count != buckets_count_)
             {
+                // The previous table is freed first so that both tables don't need to fit
+                // in memory at the same time.
+                auto previous_count = buckets_count_;
+                FreeLargePages(allocation_);
+
+                bool allocated = Allocate(new_count);
+                if (!allocated)
+                {
+                    auto min_count = CalculateNumberEntry(kMinSizeTable);
+                    if (previous_count <= min_count || !Allocate(previous_count))
+                    {
+                        Allocate(min_count);
+                    }
+                }
+
+                // This is the first touch of the pages, so clearing the table in
+                // parallel also spreads the page faults across the threads.
                 if (data_ != nullptr)
                 {
-                    std::free(data_);
+                    Empty();
                 }
 
-                buckets_count_ = new_count;
-                data_ = static_cast<Bucket*>(std::aligned_alloc(kAssumedCacheLineSize, buckets_count_ * sizeof(Bucket)));
-                mask_ = buckets_count_ - 1;
+                if (!allocated)
+                {
+                    throw std::bad_alloc();
+                }
             }
         }
 
+        /// Returns the size of the hash table in bytes.
+        inline size_t size() const { return buckets_count_ * sizeof(Bucket); }
+
+        /// Returns the type of pages backing the hash table.
+        inline PageMode page_mode() const { return allocation_.mode; }
+
         /// Remove all data from the hash table. This is not normally needed as outdated
         /// data will usually not have a negative impact on performance. This is needed
         /// when running benchmarks reusing the sames positions multiples times. If the
@@ -99,28 +144,73 @@ namespace m8::transposition
         /// table was used by a previous table and contains valid entries data. When this
         /// happens it will positively incluence the performance and make the benchmark
         /// unreliable.
+        ///
+        /// Large tables are cleared by multiple threads, each one clearing a contiguous
+        /// part of the table.
         inline void Empty()
         {
-#           pragma GCC diagnostic push
-#           pragma GCC diagnostic ignored "-Wclass-memaccess"
+            auto threads_count = std::clamp<size_t>(size() / kMinClearSizePerThread,
+                                                    1,
+                                                    (std::max)(std::thread::hardware_concurrency(), 1u));
+            auto chunk = buckets_count_ / threads_count;
 
-            std::memset(data_, 0, buckets_count_ * sizeof(Bucket));
-            
-#           pragma GCC diagnostic pop
+            std::vector<std::thread> threads;
+            for (size_t i = 1; i < threads_count; ++i)
+            {
+                auto last = i + 1 == threads_count ? buckets_count_ : (i + 1) * chunk;
+                threads.emplace_back([this, first = i * chunk, last]() { EmptyRange(first, last); });
+            }
+
+            EmptyRange(0, chunk);
+
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
         }
         
     private:
         static inline const size_t kAssumedCacheLineSize = 64;
         static inline const size_t kMinSizeTable = 1 * 1024 * 1024;
+        static inline const size_t kMinClearSizePerThread = 64 * 1024 * 1024;
+
+        LargePageAllocation allocation_;
+        Bucket*             data_;
+        size_t              buckets_count_;
+        std::uint8_t        generation_;
+
+        /// Allocate the memory of the table.
+        ///
+        /// @return false if the memory can't be allocated. The table is then empty.
+        inline bool Allocate(size_t buckets_count)
+        {
+            allocation_ = AllocateLargePages(buckets_count * sizeof(Bucket), kAssumedCacheLineSize);
+            data_ = static_cast<Bucket*>(allocation_.data);
+            buckets_count_ = data_ != nullptr ? buckets_count : 0;
+            return data_ != nullptr;
+        }
 
-        Bucket*      data_;
-        size_t       buckets_count_;
-        ZobristKey   mask_;
-        std::uint8_t generation_;
+        inline void EmptyRange(size_t first, size_t last)
+        {
+#           pragma GCC diagnostic push
+#           pragma GCC diagnostic ignored "-Wclass-memaccess"
+
+            std::memset(data_ + first, 0, (last - first) * sizeof(Bucket));
+
+#           pragma GCC diagnostic pop
+        }
+
+        /// Returns the index of the bucket of a key. The index is computed from the most
+        /// significant bits of the key, so the number of buckets doesn't need to be a
+        /// power of two. The entries must not rely on these bits to verify the key.
+        inline size_t GetBucketIndex(ZobristKey key) const
+        {
+            return static_cast<size_t>(MulHi64(key, buckets_count_));
+        }
 
         inline static size_t CalculateNumberEntry(size_t size)
         {
-            return (UINT64_C(1) << GetMsb((std::max)(size, kMinSizeTable))) / sizeof(Bucket);
+            return (std::max)(size, kMinSizeTable) / sizeof(Bucket);
         }
     };
 }
@@ -0,0 +1,58 @@
+/// @file LargePages.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains functions to allocate large memory blocks backed by huge pages.
+
+#ifndef M8_LARGE_PAGES_HPP_
+#define M8_LARGE_PAGES_HPP_
+
+#include <cstddef>
+#include <string_view>
+
+namespace m8
+{
+    /// Type of pages backing a memory block.
+    enum class PageMode
+    {
+        /// Regular pages of the operating system.
+        Normal,
+
+        /// Transparent huge pages. The kernel backs the block with huge pages when it
+        /// can.
+        Transparent,
+
+        /// Huge pages reserved by the administrator (MAP_HUGETLB).
+        Huge
+    };
+
+    /// Memory block allocated by AllocateLargePages.
+    struct LargePageAllocation
+    {
+        /// Address of the block.
+        void* data = nullptr;
+
+        /// Size of the block in bytes. It can be larger than the size requested.
+        std::size_t size = 0;
+
+        /// Type of pages backing the block.
+        PageMode mode = PageMode::Normal;
+    };
+
+    /// Allocate a memory block, trying to back it with 2 MB pages to reduce the TLB
+    /// misses when it is accessed randomly. Reserved huge pages are tried first, then
+    /// transparent huge pages and finally regular pages.
+    ///
+    /// @param size      Size of the block in bytes.
+    /// @param alignment Minimum alignment of the block.
+    /// @return The allocated block. Its data is null if the allocation failed.
+    LargePageAllocation AllocateLargePages(std::size_t size, std::size_t alignment);
+
+    /// Free a memory block allocated by AllocateLargePages.
+    void FreeLargePages(const LargePageAllocation& allocation);
+
+    /// Returns a description of a page mode.
+    std::string_view ToString(PageMode mode);
+}
+
+#endif // M8_LARGE_PAGES_HPP_
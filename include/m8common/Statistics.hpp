@@ -0,0 +1,102 @@
+/// @file Statistics.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains statistics helpers used to compare measurements.
+
+#ifndef M8_STATISTICS_HPP_
+#define M8_STATISTICS_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <boost/math/distributions/students_t.hpp>
+
+namespace m8
+{
+    /// Summary of a sample of measurements.
+    struct SampleStatistics
+    {
+        /// Number of measurements in the sample.
+        std::size_t size = 0;
+
+        /// Mean of the sample.
+        double mean = 0;
+
+        /// Standard deviation of the sample.
+        double std_dev = 0;
+
+        /// Half width of the 95% confidence interval of the mean.
+        double ci95 = 0;
+    };
+
+    /// Remove the smallest and largest values of a sample. The sample is left untouched
+    /// if it contains less than three values.
+    inline std::vector<double> TrimExtremes(std::vector<double> values)
+    {
+        if (values.size() < 3)
+        {
+            return values;
+        }
+
+        std::sort(values.begin(), values.end());
+        return std::vector<double>(values.begin() + 1, values.end() - 1);
+    }
+
+    /// Compute the mean, the standard deviation and the confidence interval of a sample.
+    inline SampleStatistics ComputeStatistics(const std::vector<double>& values)
+    {
+        SampleStatistics stats;
+        stats.size = values.size();
+        if (values.empty())
+        {
+            return stats;
+        }
+
+        stats.mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+        if (values.size() < 2)
+        {
+            return stats;
+        }
+
+        auto squares = std::accumulate(values.begin(), values.end(), 0.0,
+                                       [&stats](double sum, double value) { return sum + (value - stats.mean) * (value - stats.mean); });
+        stats.std_dev = std::sqrt(squares / (values.size() - 1));
+
+        boost::math::students_t distribution(static_cast<double>(values.size() - 1));
+        stats.ci95 = boost::math::quantile(boost::math::complement(distribution, 0.025)) * stats.std_dev / std::sqrt(static_cast<double>(values.size()));
+
+        return stats;
+    }
+
+    /// Welch's t-test. Test if two samples have the same mean without assuming that they
+    /// have the same variance.
+    ///
+    /// @return The two-sided p-value. A small value means that the means are different.
+    inline double WelchTTest(const SampleStatistics& lhs, const SampleStatistics& rhs)
+    {
+        if (lhs.size < 2 || rhs.size < 2)
+        {
+            return 1.0;
+        }
+
+        auto lhs_var = lhs.std_dev * lhs.std_dev / lhs.size;
+        auto rhs_var = rhs.std_dev * rhs.std_dev / rhs.size;
+        auto std_err = std::sqrt(lhs_var + rhs_var);
+        if (std_err == 0)
+        {
+            return lhs.mean == rhs.mean ? 1.0 : 0.0;
+        }
+
+        auto t = (lhs.mean - rhs.mean) / std_err;
+        auto freedom = (lhs_var + rhs_var) * (lhs_var + rhs_var)
+                     / (lhs_var * lhs_var / (lhs.size - 1) + rhs_var * rhs_var / (rhs.size - 1));
+
+        boost::math::students_t distribution(freedom);
+        return 2 * boost::math::cdf(boost::math::complement(distribution, std::abs(t)));
+    }
+}
+
+#endif // M8_STATISTICS_HPP_
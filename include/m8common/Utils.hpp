@@ -17,6 +17,10 @@
 #include <numeric>
 #include <vector>
 
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
 namespace m8
 {
     /**
@@ -100,6 +104,18 @@ namespace m8
     {
         return ((static_cast<T>(1) << size) - 1) << position;
     }
+
+    /// Returns the 64 most significant bits of the 128 bits product of two integers.
+    /// MulHi64(x, n) maps a uniformly distributed x to [0, n) without a division.
+    inline std::uint64_t MulHi64(std::uint64_t lhs, std::uint64_t rhs)
+    {
+#if defined(_MSC_VER)
+        return __umulh(lhs, rhs);
+#else
+        __extension__ typedef unsigned __int128 uint128_t;
+        return static_cast<std::uint64_t>((static_cast<uint128_t>(lhs) * rhs) >> 64);
+#endif
+    }
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,124 @@
+/// @file WorkStealingDeque.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains a lock-free work stealing deque.
+
+#ifndef M8_WORK_STEALING_DEQUE_HPP_
+#define M8_WORK_STEALING_DEQUE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace m8
+{
+    /// Lock-free, fixed capacity, work stealing deque (Chase-Lev). The owner thread
+    /// pushes and pops items at the bottom of the deque while the other threads steal
+    /// items from the top.
+    ///
+    /// @tparam T         Type of the items. The deque only stores pointers to the items.
+    /// @tparam kCapacity Maximum number of items in the deque.
+    template<typename T, std::size_t kCapacity>
+    class WorkStealingDeque
+    {
+    public:
+        /// Constructor.
+        WorkStealingDeque()
+        : top_(0),
+          bottom_(0)
+        {
+            for (auto& item : items_)
+            {
+                item.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        /// Push an item at the bottom of the deque. Can only be called by the owner
+        /// thread.
+        ///
+        /// @param item Item to push.
+        /// @return False if the deque is full.
+        bool Push(T* item)
+        {
+            auto bottom = bottom_.load(std::memory_order_relaxed);
+            auto top = top_.load(std::memory_order_acquire);
+
+            if (static_cast<std::int64_t>(kCapacity) <= bottom - top)
+            {
+                return false;
+            }
+
+            items_[bottom % kCapacity].store(item, std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// Pop the item at the bottom of the deque. Can only be called by the owner
+        /// thread.
+        ///
+        /// @return The item or nullptr if the deque is empty.
+        T* Pop()
+        {
+            auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            bottom_.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = top_.load(std::memory_order_relaxed);
+
+            if (bottom < top)
+            {
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = items_[bottom % kCapacity].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // This is the last item, we race against the thieves for it.
+                if (!top_.compare_exchange_strong(top, top + 1,
+                                                  std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        /// Steal the item at the top of the deque. Can be called by any thread.
+        ///
+        /// @return The item or nullptr if the deque is empty or if another thread took
+        ///         the item first.
+        T* Steal()
+        {
+            auto top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto bottom = bottom_.load(std::memory_order_acquire);
+
+            if (bottom <= top)
+            {
+                return nullptr;
+            }
+
+            T* item = items_[top % kCapacity].load(std::memory_order_relaxed);
+            if (!top_.compare_exchange_strong(top, top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+
+            return item;
+        }
+
+    private:
+        alignas(64) std::atomic<std::int64_t> top_;
+        alignas(64) std::atomic<std::int64_t> bottom_;
+        alignas(64) std::array<std::atomic<T*>, kCapacity> items_;
+    };
+}
+
+#endif // M8_WORK_STEALING_DEQUE_HPP_
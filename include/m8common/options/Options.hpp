@@ -43,6 +43,27 @@ namespace m8::options
         /// Options of the perft command
         std::int32_t perft_threads = 16;
 
+        /// Size of the perft hash table in megabytes. Zero disable the table.
+        std::uint32_t perft_hash = 64;
+
+        /// Number of threads used by the search (Lazy SMP).
+        std::uint32_t threads = 1;
+
+        /// Parameters of the late move reductions. The base reduction of a move, in 
+        /// plies, is (lmr_base + 100 * ln(depth) * ln(move_number) / lmr_divisor) / 100.
+        std::int32_t lmr_base = 75;
+        std::int32_t lmr_divisor = 225;
+
+        /// Minimum depth at which moves are reduced.
+        std::int32_t lmr_min_depth = 3;
+
+        /// Number of legal moves searched at full depth before moves are reduced.
+        std::int32_t lmr_full_depth_moves = 3;
+
+        /// The reduction is decreased by one ply for each lmr_history_divisor points of
+        /// history score of the move (and increased for negative scores).
+        std::int32_t lmr_history_divisor = 8192;
+
         /// Max log severity
         severity_level max_log_severity;
 
@@ -6,6 +6,7 @@
 #ifndef M8_STRING_HELPERS_HPP_
 #define M8_STRING_HELPERS_HPP_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,22 @@ namespace m8
     /// @param str String to split
     /// @return a vector containing all the "words" in the string.
     std::vector<std::string> Split(const std::string& str);
+
+    /// Parse a comma separated list of positive numbers (e.g. "1,2,4,8").
+    ///
+    /// @param str String to parse.
+    /// @return The numbers in the order of the list.
+    /// @throws std::invalid_argument If an element of the list is not a positive number.
+    std::vector<std::uint32_t> ParseNumberList(const std::string& str);
+
+    /// Parse a comma separated list of numbers of threads (e.g. "2,4,8") for a scaling
+    /// test. The speedups are relative to a single thread, so 1 is always moved or added
+    /// to the front of the list.
+    ///
+    /// @param str String to parse.
+    /// @return The numbers of threads, starting with 1.
+    /// @throws std::invalid_argument If an element of the list is not a positive number.
+    std::vector<std::uint32_t> ParseThreadCounts(const std::string& str);
 }
 
 #endif // M8_STRING_HELPERS_HPP_
\ No newline at end of file
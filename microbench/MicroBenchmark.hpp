@@ -0,0 +1,122 @@
+/// @file MicroBenchmark.hpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains a small harness to time the hot primitives of m8 in isolation.
+
+#ifndef M8_MICROBENCH_MICRO_BENCHMARK_HPP_
+#define M8_MICROBENCH_MICRO_BENCHMARK_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#endif
+
+namespace m8::microbench
+{
+    /// Read the time stamp counter of the processor. Returns 0 on the architectures
+    /// where it is not available.
+    inline std::uint64_t ReadCycles()
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    /// Prevent the compiler from optimizing away the computation of a value.
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    /// Result of a micro benchmark.
+    struct MicroBenchmarkResult
+    {
+        /// Name of the primitive timed.
+        std::string name;
+
+        /// Number of operations executed by the fastest repetition.
+        std::uint64_t operations = 0;
+
+        /// Nanoseconds per operation of the fastest repetition.
+        double ns_per_op = 0;
+
+        /// Processor cycles per operation of the fastest repetition. 0 if the cycle
+        /// counter is not available.
+        double cycles_per_op = 0;
+
+        /// Operations per second of the fastest repetition.
+        double ops_per_second = 0;
+    };
+
+    /// Time a primitive. The function executes a batch of operations and returns the
+    /// number of operations executed. It is called repeatedly during each repetition,
+    /// so that the duration of a repetition is much longer than the resolution of the
+    /// clock.
+    ///
+    /// The fastest repetition is reported, the slower ones being caused by interrupts
+    /// and other processes.
+    ///
+    /// @param name        Name of the primitive.
+    /// @param warmups     Number of repetitions executed before the measures, to fill the
+    ///                    caches and let the processor reach its frequency.
+    /// @param repetitions Number of repetitions measured.
+    /// @param min_time    Minimum duration of a repetition.
+    /// @param function    Function executing a batch of operations.
+    inline MicroBenchmarkResult Measure(const std::string& name,
+                                        std::uint32_t warmups,
+                                        std::uint32_t repetitions,
+                                        std::chrono::nanoseconds min_time,
+                                        const std::function<std::uint64_t()>& function)
+    {
+        MicroBenchmarkResult result;
+        result.name = name;
+
+        for (std::uint32_t i = 0; i < warmups + std::max(repetitions, 1u); ++i)
+        {
+            std::uint64_t operations = 0;
+            std::chrono::steady_clock::duration elapsed;
+            auto start = std::chrono::steady_clock::now();
+            auto start_cycles = ReadCycles();
+            do
+            {
+                operations += function();
+                elapsed = std::chrono::steady_clock::now() - start;
+            } while (elapsed < min_time && operations);
+            auto cycles = ReadCycles() - start_cycles;
+
+            if (i < warmups || !operations)
+            {
+                continue;
+            }
+
+            auto ns_per_op = std::chrono::duration<double, std::nano>(elapsed).count() / operations;
+            if (result.operations == 0 || ns_per_op < result.ns_per_op)
+            {
+                result.operations = operations;
+                result.ns_per_op = ns_per_op;
+                result.cycles_per_op = static_cast<double>(cycles) / operations;
+                result.ops_per_second = 1e9 / ns_per_op;
+            }
+        }
+
+        return result;
+    }
+}
+
+#endif // M8_MICROBENCH_MICRO_BENCHMARK_HPP_
@@ -0,0 +1,299 @@
+/// @file microbench_main.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+/// @brief Contains the entry point of the micro benchmarks of the hot primitives of m8.
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "m8chess/eval/Eval.hpp"
+#include "m8chess/movegen/Attacks.hpp"
+#include "m8chess/movegen/MoveGeneration.hpp"
+#include "m8chess/transposition/TranspositionTable.hpp"
+#include "m8chess/Board.hpp"
+#include "m8chess/Checkmate.hpp"
+#include "m8chess/Init.hpp"
+#include "m8chess/SAN.hpp"
+
+#include "MicroBenchmark.hpp"
+
+namespace m8::microbench
+{
+    namespace po = boost::program_options;
+    namespace pt = boost::property_tree;
+
+    /// Load the positions of an EPD file and all the positions one move after them.
+    /// The second ply brings positions with checks, captures and promotions that the
+    /// test positions lack.
+    std::vector<Board> LoadPositions(const std::string& filename)
+    {
+        std::ifstream file(filename);
+        if (!file)
+        {
+            throw std::runtime_error("Unable to open the positions file " + filename + ".");
+        }
+
+        std::vector<Board> positions;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream line_stream(line);
+            std::string field;
+            std::string fen;
+            for (int i = 0; i < 4 && line_stream >> field; ++i)
+            {
+                fen += (i ? " " : "") + field;
+            }
+
+            if (fen.empty() || fen[0] == '#')
+            {
+                continue;
+            }
+
+            Board board(fen);
+            positions.push_back(board);
+
+            MoveList moves;
+            movegen::GenerateLegalMoves(board, moves);
+            for (auto move : moves)
+            {
+                Board child = board;
+                child.Make(move.move);
+                positions.push_back(child);
+            }
+        }
+
+        return positions;
+    }
+
+    /// The legal moves of each position, used by the benchmarks of the primitives that
+    /// need a move.
+    std::vector<MoveList> GenerateMoves(const std::vector<Board>& positions)
+    {
+        std::vector<MoveList> moves(positions.size());
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            movegen::GenerateLegalMoves(positions[i], moves[i]);
+        }
+        return moves;
+    }
+
+    std::vector<std::pair<std::string, std::function<std::uint64_t()>>> CreateBenchmarks(std::vector<Board>& positions,
+                                                                                         const std::vector<MoveList>& moves,
+                                                                                         transposition::TranspositionTable& tt)
+    {
+        return
+        {
+            {"GenerateAllMoves", [&]()
+            {
+                for (auto& board : positions)
+                {
+                    MoveList list;
+                    movegen::GenerateAllMoves(board, list);
+                    DoNotOptimize(list.size());
+                }
+                return positions.size();
+            }},
+            {"GenerateAllCaptures", [&]()
+            {
+                for (auto& board : positions)
+                {
+                    MoveList list;
+                    movegen::GenerateAllCaptures(board, list);
+                    DoNotOptimize(list.size());
+                }
+                return positions.size();
+            }},
+            {"Board::Make/Unmake", [&]()
+            {
+                std::uint64_t operations = 0;
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                {
+                    for (auto move : moves[i])
+                    {
+                        auto unmake_info = positions[i].Make(move.move);
+                        DoNotOptimize(positions[i].hash());
+                        positions[i].Unmake(move.move, unmake_info);
+                    }
+                    operations += moves[i].size();
+                }
+                return operations;
+            }},
+            {"IsInCheck", [&]()
+            {
+                for (auto& board : positions)
+                {
+                    DoNotOptimize(IsInCheck(board.side_to_move(), board));
+                }
+                return positions.size();
+            }},
+            {"GenerateRookAttacks", [&]()
+            {
+                for (auto& board : positions)
+                {
+                    for (Sq sq = kA1; sq <= kH8; ++sq)
+                    {
+                        DoNotOptimize(movegen::GenerateRookAttacks(board.bb_occupied(), sq));
+                    }
+                }
+                return positions.size() * kNumSqOnBoard;
+            }},
+            {"GenerateBishopAttacks", [&]()
+            {
+                for (auto& board : positions)
+                {
+                    for (Sq sq = kA1; sq <= kH8; ++sq)
+                    {
+                        DoNotOptimize(movegen::GenerateBishopAttacks(board.bb_occupied(), sq));
+                    }
+                }
+                return positions.size() * kNumSqOnBoard;
+            }},
+            {"TranspositionTable::Insert", [&]()
+            {
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                {
+                    auto move = moves[i].any() ? moves[i].begin()->move : kNullMove;
+                    tt.Insert(positions[i].hash(), move, transposition::EntryType::Exact, 5, 0, 0);
+                }
+                return positions.size();
+            }},
+            {"TranspositionTable::operator[]", [&]()
+            {
+                for (auto& board : positions)
+                {
+                    DoNotOptimize(tt[board.hash()]);
+                }
+                return positions.size();
+            }},
+            {"eval::Evaluate", [&]()
+            {
+                for (auto& board : positions)
+                {
+                    DoNotOptimize(eval::Evaluate(board));
+                }
+                return positions.size();
+            }},
+            {"RenderSAN", [&]()
+            {
+                std::uint64_t operations = 0;
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                {
+                    for (auto move : moves[i])
+                    {
+                        DoNotOptimize(RenderSAN(move.move, positions[i]).size());
+                    }
+                    operations += moves[i].size();
+                }
+                return operations;
+            }}
+        };
+    }
+
+    void WriteJson(const std::string& filename, std::size_t positions, const std::vector<MicroBenchmarkResult>& results)
+    {
+        pt::ptree tree;
+        tree.put("positions", positions);
+
+        pt::ptree benchmarks;
+        for (auto& result : results)
+        {
+            pt::ptree benchmark;
+            benchmark.put("name", result.name);
+            benchmark.put("operations", result.operations);
+            benchmark.put("ns_per_op", result.ns_per_op);
+            benchmark.put("cycles_per_op", result.cycles_per_op);
+            benchmark.put("ops_per_second", result.ops_per_second);
+            benchmarks.push_back(std::make_pair("", benchmark));
+        }
+        tree.add_child("benchmarks", benchmarks);
+
+        pt::write_json(filename, tree);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace m8;
+    using namespace m8::microbench;
+
+    std::string positions_file;
+    std::string json_file;
+    std::string filter;
+    std::uint32_t warmups;
+    std::uint32_t repetitions;
+    std::uint32_t min_time;
+    std::size_t tt_size;
+
+    po::options_description options("m8-microbench options");
+    options.add_options()
+        ("help",        "Show this help.")
+        ("positions",   po::value<std::string>(&positions_file)->default_value("perft-suite.epd"), "EPD file containing the positions used. The positions one move after them are also used.")
+        ("warmups",     po::value<std::uint32_t>(&warmups)->default_value(3), "Number of repetitions executed before the measures.")
+        ("repetitions", po::value<std::uint32_t>(&repetitions)->default_value(20), "Number of repetitions measured. The fastest one is reported.")
+        ("min-time",    po::value<std::uint32_t>(&min_time)->default_value(10), "Minimum duration of a repetition in milliseconds.")
+        ("filter",      po::value<std::string>(&filter), "Only run the benchmarks with a name containing this text.")
+        ("hash",        po::value<std::size_t>(&tt_size)->default_value(16), "Size of the transposition table in megabytes.")
+        ("json",        po::value<std::string>(&json_file), "Name of a file where the results are saved in json.");
+
+    try
+    {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, options), vm);
+        po::notify(vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << options << std::endl;
+            return 0;
+        }
+
+        InitializePreCalc();
+
+        auto positions = LoadPositions(positions_file);
+        auto moves = GenerateMoves(positions);
+        transposition::TranspositionTable tt(tt_size * 1024 * 1024);
+
+        std::cout << "Positions: " << positions.size() << "\n\n"
+                  << std::left << std::setw(32) << "Benchmark"
+                  << std::right << std::setw(12) << "ns/op"
+                  << std::setw(14) << "cycles/op"
+                  << std::setw(16) << "ops/s" << '\n';
+
+        std::vector<MicroBenchmarkResult> results;
+        for (auto& [name, function] : CreateBenchmarks(positions, moves, tt))
+        {
+            if (name.find(filter) == std::string::npos)
+            {
+                continue;
+            }
+
+            auto result = Measure(name, warmups, repetitions, std::chrono::milliseconds(min_time), function);
+            std::cout << std::left << std::setw(32) << result.name
+                      << std::right << std::fixed
+                      << std::setprecision(2) << std::setw(12) << result.ns_per_op
+                      << std::setprecision(1) << std::setw(14) << result.cycles_per_op
+                      << std::setprecision(0) << std::setw(16) << result.ops_per_second << std::endl;
+            results.push_back(result);
+        }
+
+        if (!json_file.empty())
+        {
+            WriteJson(json_file, positions.size(), results);
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -39,7 +39,6 @@ namespace m8
         out <<board_ <<std::endl;
 
         transposition::TranspositionTable transposition_table(options::Options::get().tt_size * 1024 * 1024);
-        transposition_table.Empty();
 
         search::Searcher searcher(transposition_table);
         searcher.Attach(this);
@@ -4,16 +4,25 @@
 /// @brief Contains the implementations details of the Benchmark class.
 
 #include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <sstream>
+#include <numeric>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
 
 #include "m8common/options/Options.hpp"
 #include "m8common/Output.hpp"
+#include "m8common/Utils.hpp"
 
 #include "m8chess/Benchmark.hpp"
 #include "m8chess/TimeManager.hpp"
 
 namespace m8
 {
-    std::array<std::pair<std::string, DepthType>, 64> Benchmark::positions = 
+    std::array<std::pair<std::string, DepthType>, 64> Benchmark::default_positions = 
     {{
         {"8/3p4/p1bk3p/Pp6/1Kp1PpPp/2P2P1P/2P5/5B2 b",                     16},
         {"2r3k1/1p2q1pp/2b1pr2/p1pp4/6Q1/1P1PP1R1/P1PN2PP/5RK1 w",          9},
@@ -81,14 +90,156 @@ namespace m8
         {"8/3p3B/5p2/5P2/p7/PP5b/k7/6K1 w",                                18}
     }};
 
-    Benchmark::Benchmark(DepthType deltaDepth, std::uint32_t runs, std::uint32_t threads)
+    namespace
+    {
+        namespace pt = boost::property_tree;
+
+        /// Observer that keeps the depth of the last iteration completed and stops the
+        /// search once it searched enough nodes.
+        class IterationObserver : public search::ISearchObserver<search::PV, Move>
+        {
+        public:
+            IterationObserver(search::Search& search, std::optional<NodeCounterType> nodes)
+            : search_(search),
+              nodes_(nodes)
+            {}
+
+            void OnIterationCompleted(const search::PV& pv, EvalType eval, DepthType depth, double time, NodeCounterType nodes)
+            {
+                depth_ = depth;
+                if (nodes_ && *nodes_ <= nodes)
+                {
+                    search_.Abort();
+                }
+            }
+
+            DepthType depth() const { return depth_; }
+
+        private:
+            search::Search& search_;
+            std::optional<NodeCounterType> nodes_;
+            DepthType depth_ = 0;
+        };
+
+        /// Game phases used to group the results, with the highest game phase estimate of
+        /// each phase. The estimate only measures the material left, so it can't tell an
+        /// opening from a middlegame where most of the pieces are still on the board. The
+        /// phases are named after the range of estimates they contain.
+        const std::array<std::pair<std::string_view, eval::GamePhaseEstimate>, 3> kPhases =
+        {{
+            {"Endgame (0-8)",                  8},
+            {"Middlegame (9-16)",             16},
+            {"Early middlegame/Opening (17+)", eval::kGamePhaseEstimateMax}
+        }};
+
+        std::size_t GetPhase(std::string_view fen)
+        {
+            auto estimate = Board(fen).game_phase_estimate();
+            for (std::size_t i = 0; i < kPhases.size() - 1; ++i)
+            {
+                if (estimate <= kPhases[i].second)
+                {
+                    return i;
+                }
+            }
+
+            // With promotions the estimate can be higher than the maximum.
+            return kPhases.size() - 1;
+        }
+
+        /// Depth of the searches limited by nodes or time.
+        const DepthType kUnlimitedDepth = 100;
+
+        pt::ptree ToPtree(const SampleStatistics& stats)
+        {
+            pt::ptree tree;
+            tree.put("mean", stats.mean);
+            tree.put("std_dev", stats.std_dev);
+            tree.put("ci95", stats.ci95);
+            return tree;
+        }
+    }
+
+    Benchmark::Benchmark(DepthType deltaDepth,
+                         std::uint32_t runs,
+                         std::uint32_t threads,
+                         const std::string& json_file,
+                         const std::string& baseline_file)
     : deltaDepth_(deltaDepth),
-      runs_(runs),
-      threads_count_(threads)
+      runs_(std::max(runs, 1u)),
+      threads_count_(std::max(threads, 1u)),
+      json_file_(json_file),
+      baseline_file_(baseline_file),
+      tt_size_(0),
+      positions_(default_positions.begin(), default_positions.end())
     {}
 
+    void Benchmark::LoadEpd(const std::string& filename)
+    {
+        std::ifstream file(filename);
+        if (!file)
+        {
+            throw BenchmarkError("Unable to open the positions file " + filename + ".");
+        }
+
+        positions_.clear();
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream line_stream(line);
+            std::string field;
+            std::string fen;
+            for (int i = 0; i < 4 && line_stream >> field; ++i)
+            {
+                fen += (i ? " " : "") + field;
+            }
+
+            if (fen.empty() || fen[0] == '#')
+            {
+                continue;
+            }
+
+            // The fen is validated now so that an invalid position is not reported in the
+            // middle of the benchmark.
+            Board board(fen);
+            positions_.emplace_back(fen, 0);
+        }
+
+        if (positions_.empty())
+        {
+            throw BenchmarkError("There is no position in " + filename + ".");
+        }
+    }
+
+    void Benchmark::SetLimits(std::optional<DepthType> depth,
+                              std::optional<NodeCounterType> nodes,
+                              std::optional<std::chrono::milliseconds> move_time)
+    {
+        depth_ = depth;
+        nodes_ = nodes;
+        move_time_ = move_time;
+    }
+
+    void Benchmark::ValidateLimits() const
+    {
+        if (depth_ || nodes_ || move_time_)
+        {
+            return;
+        }
+
+        if (std::ranges::any_of(positions_, [](auto& position) { return position.second == 0; }))
+        {
+            throw BenchmarkError("The positions loaded from an EPD file need a depth, nodes or time limit.");
+        }
+    }
+
     void Benchmark::Run()
     {
+        ValidateLimits();
+
+        // The runs executed in parallel share the memory allowed for the transposition table.
+        tt_size_ = options::Options::get().tt_size * 1024 * 1024 / threads_count_;
         abort_ = false;
         results_.clear();
         results_.reserve(runs_);
@@ -102,46 +253,289 @@ namespace m8
         {
             thread.join();
         }
+        threads_.clear();
+
+        // Some threads could have completed a run after the last one we need.
+        results_.resize(runs_);
+
+        std::vector<BenchmarkResult> position_results(positions_.size());
+        std::vector<double> nps_samples;
+        std::vector<double> time_samples;
+        for (auto& run : results_)
+        {
+            auto result = std::accumulate(run.begin(), run.end(), BenchmarkResult());
+            nps_samples.push_back(static_cast<double>(result.nps()));
+            time_samples.push_back(ToFSec(result.duration()).count());
+
+            for (std::size_t i = 0; i < run.size(); ++i)
+            {
+                position_results[i] += run[i];
+            }
+        }
+
+        // The fastest and the slowest runs are removed because they are often caused by
+        // other processes running on the machine.
+        auto nps = ComputeStatistics(TrimExtremes(nps_samples));
+        auto time = ComputeStatistics(TrimExtremes(time_samples));
+
+        Output out;
+        NodeCounterType nodes = 0;
+        for (std::size_t i = 0; i < positions_.size(); ++i)
+        {
+            auto& result = position_results[i];
+            out << positions_[i].first << '\t'
+                << "Depth: " << result.depth() << '\t'
+                << "Nodes: " << result.nodes() / runs_ << '\t'
+                << "Time: "  << ToFSec(result.duration()).count() / runs_ << '\n';
+
+            nodes += result.nodes() / runs_;
+        }
+
+        PrintPhases(out, position_results);
+
+        auto total = std::accumulate(position_results.begin(), position_results.end(), BenchmarkResult());
+        out << '\n'
+            << "Search threads: "   << options::Options::get().threads << '\n'
+            << "Hash pages: "       << ToString(tt_page_mode_.load()) << '\n'
+            << "Hash hit rate: "    << FormatPercentage(static_cast<float>(total.tt_hit_rate()), 2) << '\n'
+            << "Runs: "             << runs_ << " (" << nps.size << " kept)" << '\n'
+            << "Nodes: "            << nodes << '\n'
+            << "Time: "             << time.mean << " +/- " << time.ci95 << " (std dev " << time.std_dev << ")" << '\n'
+            << "Nodes per second: " << AddMetricSuffix(static_cast<std::uint64_t>(nps.mean), 2)
+            << " +/- " << AddMetricSuffix(static_cast<std::uint64_t>(nps.ci95), 2)
+            << " (std dev " << AddMetricSuffix(static_cast<std::uint64_t>(nps.std_dev), 2) << ")" << std::endl;
+
+        if (!json_file_.empty())
+        {
+            WriteJson(nps, time);
+        }
+
+        if (!baseline_file_.empty())
+        {
+            CompareToBaseline(nps_samples, nodes);
+        }
+    }
+
+    void Benchmark::RunSignature()
+    {
+        ValidateLimits();
+
+        options::Options::get().threads = 1;
+        tt_size_ = kSignatureTTSize;
+        abort_ = false;
+
+        auto results = RunBenchmark();
+        auto result = std::accumulate(results.begin(), results.end(), BenchmarkResult());
 
-        auto result = std::accumulate(results_.begin(), results_.begin() + runs_, BenchmarkResult());
-        
         Output out;
-        out << "Nodes: "            << result.nodes()                   << '\n'
-            << "Time: "             << ToFSec(result.duration())        << '\n'
+        out << "Signature: "        << result.nodes()                   << '\n'
             << "Nodes per second: " << AddMetricSuffix(result.nps(), 2) << std::endl;
     }
 
+    void Benchmark::PrintPhases(Output& out, const std::vector<BenchmarkResult>& position_results) const
+    {
+        std::array<BenchmarkResult, kPhases.size()> phase_results;
+        std::array<std::size_t, kPhases.size()> phase_positions = {};
+        for (std::size_t i = 0; i < positions_.size(); ++i)
+        {
+            auto phase = GetPhase(positions_[i].first);
+            phase_results[phase] += position_results[i];
+            ++phase_positions[phase];
+        }
+
+        out << '\n';
+        for (std::size_t i = 0; i < kPhases.size(); ++i)
+        {
+            if (phase_positions[i] == 0)
+            {
+                continue;
+            }
+
+            auto& result = phase_results[i];
+            out << kPhases[i].first << '\t'
+                << "Positions: " << phase_positions[i] << '\t'
+                << "Nodes: " << result.nodes() / runs_ << '\t'
+                << "Time: " << ToFSec(result.duration()).count() / runs_ << '\t'
+                << "Nodes per second: " << AddMetricSuffix(result.nps(), 2) << '\n';
+        }
+    }
+
+    void Benchmark::RunScaling(const std::vector<std::uint32_t>& search_threads)
+    {
+        ValidateLimits();
+
+        tt_size_ = options::Options::get().tt_size * 1024 * 1024;
+        abort_ = false;
+
+        Output out;
+        out << "Search threads\tTime\tNodes per second\tSpeedup\tEfficiency\tTime speedup" << '\n';
+
+        double base_nps = 0;
+        double base_time = 0;
+        for (auto threads : search_threads)
+        {
+            options::Options::get().threads = threads;
+
+            std::vector<double> nps_samples;
+            std::vector<double> time_samples;
+            for (std::uint32_t run = 0; run < runs_; ++run)
+            {
+                auto results = RunBenchmark();
+                auto result = std::accumulate(results.begin(), results.end(), BenchmarkResult());
+                nps_samples.push_back(static_cast<double>(result.nps()));
+                time_samples.push_back(ToFSec(result.duration()).count());
+            }
+
+            auto nps = ComputeStatistics(TrimExtremes(nps_samples)).mean;
+            auto time = ComputeStatistics(TrimExtremes(time_samples)).mean;
+            if (base_nps == 0)
+            {
+                base_nps = nps;
+                base_time = time;
+            }
+
+            // The parallel search searches more nodes than a single thread to reach the
+            // same depth, so the time speedup is lower than the nodes per second speedup.
+            auto speedup = nps / base_nps;
+            out << threads << '\t'
+                << std::fixed << std::setprecision(3) << time << '\t'
+                << AddMetricSuffix(static_cast<std::uint64_t>(nps), 2) << '\t'
+                << std::setprecision(2) << speedup << '\t'
+                << std::setprecision(1) << speedup / threads * 100 << "%\t"
+                << std::setprecision(2) << base_time / time << std::endl;
+        }
+    }
+
+    void Benchmark::WriteJson(const SampleStatistics& nps, const SampleStatistics& time) const
+    {
+        pt::ptree tree;
+        tree.put("search_threads", options::Options::get().threads);
+        tree.put("hash_pages", std::string(ToString(tt_page_mode_.load())));
+
+        pt::ptree runs;
+        for (auto& run : results_)
+        {
+            auto result = std::accumulate(run.begin(), run.end(), BenchmarkResult());
+
+            pt::ptree run_tree;
+            run_tree.put("nodes", result.nodes());
+            run_tree.put("tt_hit_rate", result.tt_hit_rate());
+            run_tree.put("time", ToFSec(result.duration()).count());
+            run_tree.put("nps", result.nps());
+            runs.push_back(std::make_pair("", run_tree));
+        }
+        tree.add_child("runs", runs);
+        tree.add_child("nps", ToPtree(nps));
+        tree.add_child("time", ToPtree(time));
+
+        pt::ptree positions_tree;
+        for (std::size_t i = 0; i < positions_.size(); ++i)
+        {
+            BenchmarkResult result;
+            for (auto& run : results_)
+            {
+                result += run[i];
+            }
+
+            pt::ptree position_tree;
+            position_tree.put("fen", positions_[i].first);
+            position_tree.put("phase", kPhases[GetPhase(positions_[i].first)].first);
+            position_tree.put("depth", result.depth());
+            position_tree.put("nodes", result.nodes() / runs_);
+            position_tree.put("time", ToFSec(result.duration()).count() / runs_);
+            positions_tree.push_back(std::make_pair("", position_tree));
+        }
+        tree.add_child("positions", positions_tree);
+
+        pt::write_json(json_file_, tree);
+    }
+
+    void Benchmark::CompareToBaseline(const std::vector<double>& nps_samples, NodeCounterType nodes) const
+    {
+        pt::ptree tree;
+        pt::read_json(baseline_file_, tree);
+
+        std::vector<double> baseline_samples;
+        NodeCounterType baseline_nodes = 0;
+        for (auto& [name, run] : tree.get_child("runs"))
+        {
+            baseline_samples.push_back(run.get<double>("nps"));
+            baseline_nodes = run.get<NodeCounterType>("nodes");
+        }
+
+        auto stats = ComputeStatistics(TrimExtremes(nps_samples));
+        auto baseline = ComputeStatistics(TrimExtremes(baseline_samples));
+        auto p_value = WelchTTest(stats, baseline);
+        auto speedup = baseline.mean > 0 ? (stats.mean / baseline.mean - 1) * 100 : 0.0;
+
+        Output out;
+        out << '\n'
+            << "Baseline nodes per second: " << AddMetricSuffix(static_cast<std::uint64_t>(baseline.mean), 2)
+            << " +/- " << AddMetricSuffix(static_cast<std::uint64_t>(baseline.ci95), 2) << '\n'
+            << "Speedup: " << std::showpos << speedup << std::noshowpos << "% "
+            << "(p-value " << p_value << ", " << (p_value < 0.05 ? "significant" : "not significant") << ")" << '\n';
+
+        // With more than one search thread the searches are not deterministic and the node
+        // counts are expected to differ.
+        if (baseline_nodes != nodes)
+        {
+            out << "Warning: the baseline searched " << baseline_nodes << " nodes per run instead of " << nodes
+                << ". The searches are different." << '\n';
+        }
+        out << std::flush;
+    }
+
     BenchmarkResult Benchmark::RunPosition(std::string_view fen, DepthType depth)
     {
+        if (depth_)
+        {
+            depth = *depth_;
+        }
+        else if (nodes_ || move_time_)
+        {
+            depth = kUnlimitedDepth;
+        }
+        else
+        {
+            depth += deltaDepth_;
+        }
+
         Board board(fen);
-        auto time_manager = std::make_unique<TimeManager>(std::nullopt, std::nullopt, std::nullopt, std::nullopt, true);
-        auto search = std::make_shared<search::Search>(board, std::move(time_manager), depth + deltaDepth_);
-        transposition::TranspositionTable transposition_table(options::Options::get().tt_size * 1024 * 1024 / threads_count_ );
-        transposition_table.Empty();
+        auto time_manager = std::make_unique<TimeManager>(std::nullopt, std::nullopt, std::nullopt, move_time_, !move_time_);
+        auto search = std::make_shared<search::Search>(board, std::move(time_manager), depth);
+        transposition::TranspositionTable transposition_table(tt_size_);
+        tt_page_mode_ = transposition_table.page_mode();
         search::IterativeDeepening iterative_deepening(transposition_table);
+        IterationObserver iteration_observer(*search, nodes_);
+        iterative_deepening.Attach(&iteration_observer);
+        iterative_deepening.Attach(&search->time_manager());
 
         Timer timer(TimerDirection::Up);
         timer.Start();
         auto search_result = iterative_deepening.Start(search);
         timer.Stop();
 
-        return BenchmarkResult(timer.time_on_clock(), search_result.stats_.all_nodes());
+        return BenchmarkResult(timer.time_on_clock(),
+                               search_result.stats_.all_nodes(),
+                               iteration_observer.depth(),
+                               search_result.stats_.tt_probes,
+                               search_result.stats_.tt_hits);
     }
 
-    BenchmarkResult Benchmark::RunBenchmark()
+    std::vector<BenchmarkResult> Benchmark::RunBenchmark()
     {
-        BenchmarkResult result;
+        std::vector<BenchmarkResult> results;
 
-        for (auto position : positions)
+        for (auto& position : positions_)
         {
             if (abort_)
             {
                 break;
             }
-            result += RunPosition(position.first, position.second);
+            results.push_back(RunPosition(position.first, position.second));
         }
 
-        return result;
+        return results;
     }
 
     void Benchmark::RunBenchmarks()
@@ -4,6 +4,7 @@
 /// @date July 2023
 
 #include <algorithm>
+#include <optional>
 
 #include "m8common/options/Options.hpp"
 
@@ -16,47 +17,110 @@
 
 namespace m8
 {
-    void PerftMove::CheckSharedDone()
+    PerftNode& PerftMove::Split(std::pmr::memory_resource& arena, const Board& board, int depth)
     {
-        assert(status_ == PerftMoveStatus::Shared);
-        if (node_->done())
-        {
-            count_ = node_->count();
-            node_.reset();
-            status_ = PerftMoveStatus::Done;
-        }
+        child_ = PerftNode::Create(arena, board, depth, this);
+        return *child_;
     }
 
-    PerftNode::PerftNode(Board& board)
+    void PerftMove::ReleaseChild()
     {
-        GenerateMoves(board);
+        // The moves are trivially destructible, only the node needs to be destroyed.
+        child_->~PerftNode();
+        child_ = nullptr;
     }
 
-    void PerftNode::GenerateMoves(Board& board)
+    PerftNode* PerftNode::Create(std::pmr::memory_resource& arena,
+                                 const Board& board,
+                                 int depth,
+                                 PerftMove* parent_move)
     {
+        static_assert(std::is_trivially_destructible_v<PerftMove>);
+        static_assert(sizeof(PerftNode) % alignof(PerftMove) == 0);
+
         MoveList moves;
-        movegen::GenerateAllMoves(board, moves);
+        movegen::GenerateLegalMoves(board, moves);
+
+        // The moves are stored right after the node in the same allocation.
+        auto memory = static_cast<std::byte*>(arena.allocate(sizeof(PerftNode) + moves.size() * sizeof(PerftMove),
+                                                             alignof(PerftNode)));
+        auto node_moves = reinterpret_cast<PerftMove*>(memory + sizeof(PerftNode));
+        auto node = new (memory) PerftNode(board, depth, parent_move, node_moves, moves.size());
 
-        for (auto move : moves)
+        for (std::size_t i = 0; i < moves.size(); ++i)
         {
-            UnmakeInfo unmake_info = board.Make(move.move);
+            new (node_moves + i) PerftMove(moves[i].move, node);
+        }
 
-            if (!IsInCheck(OpposColor(board.side_to_move()), board))
-            {
-                moves_.emplace_back(move.move);
-            }
+        return node;
+    }
 
-            board.Unmake(move.move, unmake_info);
+    PerftNode::PerftNode(const Board& board, int depth, PerftMove* parent_move, PerftMove* moves, std::size_t size)
+    : board_(board),
+      depth_(depth),
+      parent_move_(parent_move),
+      pending_(size + 1),
+      moves_(moves),
+      size_(size)
+    {}
+
+    Perft::Perft(int depth, const Board& board, IPerftObserver* observer, const std::string& checkpoint_file)
+    : depth_(depth),
+      board_(board),
+      arena_(kArenaBlockSize),
+      root_(PerftNode::Create(arena_, board_, depth_, nullptr)),
+      owned_hash_table_(std::make_unique<PerftHashTable>(static_cast<std::size_t>(options::Options::get().perft_hash) * 1024 * 1024)),
+      hash_table_(owned_hash_table_.get()),
+      threads_count_(options::Options::get().perft_threads),
+      done_(false),
+      observer_(observer)
+    {
+        if (!checkpoint_file.empty())
+        {
+            checkpoint_ = std::make_unique<PerftCheckpoint>(checkpoint_file, board_.hash(), depth_);
         }
     }
 
+    Perft::Perft(int depth, const Board& board, IPerftObserver* observer, PerftHashTable& hash_table, int threads)
+    : depth_(depth),
+      board_(board),
+      arena_(kArenaBlockSize),
+      root_(PerftNode::Create(arena_, board_, depth_, nullptr)),
+      hash_table_(&hash_table),
+      threads_count_(threads),
+      done_(false),
+      observer_(observer)
+    {}
+
+    Perft::~Perft()
+    {
+        JoinThreads();
+
+        // The other nodes are destroyed as soon as they are completed and all the memory
+        // is freed at once by the arenas.
+        root_->~PerftNode();
+    }
+
     void Perft::StartThreads()
     {
-        int threads = options::Options::get().perft_threads;
-        
-        for (int i = 0; i < threads; ++i)
+        auto threads = static_cast<std::size_t>(std::max(1, threads_count_));
+
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+
+        // The root moves are distributed before the threads start, so we can push them
+        // in any queue.
+        std::size_t index = 0;
+        for (auto& move : *root_)
         {
-            threads_.push_back(std::thread(&Perft::RunThread, this));
+            workers_[index++ % threads]->queue.Push(&move);
+        }
+
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            threads_.push_back(std::thread(&Perft::RunThread, this, i));
         }
     }
 
@@ -64,112 +128,193 @@ namespace m8
     {
         start_ = std::chrono::steady_clock::now();
         StartThreads();
+        Release(*root_);
         JoinThreads();
     }
 
+    template<int kDepth>
+    std::uint64_t Perft::UnrolledPerft(Board& board)
+    {
+        static_assert(0 < kDepth);
+
+        MoveList moves;
+        movegen::GenerateLegalMoves(board, moves);
+
+        // The move generator only returns legal moves, so the leaves can be counted
+        // without making them.
+        if constexpr (kDepth == 1)
+        {
+            return moves.size();
+        }
+        else
+        {
+            std::uint64_t count = 0;
+            for (auto next = moves.begin(); next < moves.end(); ++next)
+            {
+                UnmakeInfo unmake_info = board.Make(next->move);
+                count += UnrolledPerft<kDepth - 1>(board);
+                board.Unmake(next->move, unmake_info);
+            }
+            return count;
+        }
+    }
+
     std::uint64_t Perft::RecursivePerft(Board& board, int depth)
     {
+        // The last plies are unrolled at compile time. They are also cheaper to count
+        // again than to look up in the hash table.
+        static_assert(kUnrolledDepth == 2);
+        switch (depth)
+        {
+        case 1: return UnrolledPerft<1>(board);
+        case 2: return UnrolledPerft<2>(board);
+        }
+
         std::uint64_t count = 0;
 
+        bool use_hash_table = hash_table_->enabled();
+        if (use_hash_table && hash_table_->TryGet(board.hash(), depth, count))
+        {
+            return count;
+        }
+
         MoveList moves;
-        movegen::GenerateAllMoves(board, moves);
+        movegen::GenerateLegalMoves(board, moves);
 
         for (auto next = moves.begin(); next < moves.end(); ++next)
         {
             UnmakeInfo unmake_info = board.Make(next->move);
-
-            if (!IsInCheck(OpposColor(board.side_to_move()), board))
-            {
-                count += (depth == 1 ? 1 : RecursivePerft(board, depth - 1));
-            }
-
+            count += RecursivePerft(board, depth - 1);
             board.Unmake(next->move, unmake_info);
         }
 
+        if (use_hash_table)
+        {
+            hash_table_->Insert(board.hash(), depth, count);
+        }
+
         return count;
     }
 
-    void Perft::PerftMoveRecursive(PerftMove& move, Board& board, int depth)
+    void Perft::Execute(PerftMove& move, Worker& worker)
     {
-        move.MakeSearching();
+        auto& node = move.parent();
+        int depth = node.depth() - 1;
 
-        mutex_.unlock();
-        auto count = RecursivePerft(board, depth);
-        mutex_.lock();
+        std::uint64_t count;
+        if (checkpoint_ && checkpoint_->TryGet(GetPath(move), count))
+        {
+            Complete(move, count);
+            return;
+        }
 
-        move.MakeDone(count);
-    }
+        if (depth == 0)
+        {
+            Complete(move, 1);
+            return;
+        }
 
-    void Perft::ParallelPerft(PerftNode& node,
-                              Board& board,
-                              int depth,
-                              PerftMoveStatus node_type,
-                              bool is_root,
-                              std::function<void(PerftMove&, Board&, int)> recurse)
-    {
-        auto moves = node | std::views::filter([node_type](const PerftMove& move){ return move.status() == node_type; });
-        for (auto& move : moves)
+        Board board = node.board();
+        board.Make(move.move());
+
+        if (depth <= kMinParallelDepth || kMaxSplitPly < depth_ - depth)
         {
-            UnmakeInfo unmake_info = board.Make(move.move());
+            Complete(move, RecursivePerft(board, depth));
+            return;
+        }
 
-            if (!IsInCheck(OpposColor(board.side_to_move()), board))
-            {
-                if (depth == 1)
-                {
-                    move.MakeDone(1);
-                }
-                else if (kMinParallelDepth < depth)
-                {
-                    recurse(move, board, depth - 1);
-                }
-                else
-                {
-                    PerftMoveRecursive(move, board, depth - 1);
-                }
-            }
-            else
+        if (hash_table_->enabled() && hash_table_->TryGet(board.hash(), depth, count))
+        {
+            Complete(move, count);
+            return;
+        }
+
+        // We split the work under this move. The moves of the new node are pushed on our
+        // queue, where the idle threads can steal them. We hold a reference on the node
+        // until all the moves are pushed because they may be completed by other threads
+        // in the meantime.
+        auto& child = move.Split(worker.arena, board, depth);
+        for (auto& child_move : child)
+        {
+            if (!worker.queue.Push(&child_move))
             {
-                move.MakeDone(0);
+                Execute(child_move, worker);
             }
+        }
 
-            board.Unmake(move.move(), unmake_info);
+        Release(child);
+    }
 
-            if (is_root && move.status() == PerftMoveStatus::Done)
-            {
-                auto san_move = RenderSAN(move.move(), board_);
-                observer_->OnPartialPerftResult(san_move, move.count());
-            }
+    void Perft::Complete(PerftMove& move, std::uint64_t count)
+    {
+        move.set_count(count);
+
+        if (checkpoint_)
+        {
+            checkpoint_->Record(GetPath(move), count);
+        }
+
+        auto& node = move.parent();
+        if (&node == root_)
+        {
+            // RenderSAN temporarily makes the move on board_, so it needs the lock too.
+            std::lock_guard lock(observer_mutex_);
+            observer_->OnPartialPerftResult(RenderSAN(move.move(), board_), count);
         }
+
+        Release(node);
     }
 
-    void Perft::ContributeAtSharedNode(PerftNode& node, Board& board, int depth)
+    void Perft::Release(PerftNode& node)
     {
-        ParallelPerft(node, board, depth, PerftMoveStatus::New, false,
-            [this](PerftMove& move, Board& board, int depth)
-            {
-                PerftMoveRecursive(move, board, depth);
-            });
+        if (!node.Release())
+        {
+            return;
+        }
+
+        // All the moves of the node are done.
+        auto parent_move = node.parent_move();
+        if (parent_move == nullptr)
+        {
+            SendResult();
+            done_.store(true, std::memory_order_release);
+            return;
+        }
+
+        auto count = node.count();
+        if (hash_table_->enabled())
+        {
+            hash_table_->Insert(node.board().hash(), node.depth(), count);
+        }
+
+        parent_move->ReleaseChild();
+        Complete(*parent_move, count);
     }
 
-    void Perft::FindNodeToContribute(PerftNode& node, Board& board, int depth, bool is_root = false)
+    PerftCheckpoint::Path Perft::GetPath(const PerftMove& move) const
     {
-        // At the current node we first look for a New child that we can transform in a 
-        // Shared child and start work on it.
-        ParallelPerft(node, board, depth, PerftMoveStatus::New, is_root,
-            [this](PerftMove& move, Board& board, int depth)
-            {
-                move.MakeShared(std::make_unique<PerftNode>(board));
-                ContributeAtSharedNode(move.node(), board, depth);
-                move.CheckSharedDone();
-            });
-
-        // When there is no more New children, we look for a shared child to contribute to
-        ParallelPerft(node, board, depth, PerftMoveStatus::Shared, is_root,
-            [this](PerftMove& move, Board& board, int depth)
+        PerftCheckpoint::Path path;
+        for (auto current = &move; current != nullptr; current = current->parent().parent_move())
+        {
+            path.push_back(current->move());
+        }
+
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    PerftMove* Perft::Steal(std::size_t thief)
+    {
+        for (std::size_t i = 1; i < workers_.size(); ++i)
+        {
+            auto move = workers_[(thief + i) % workers_.size()]->queue.Steal();
+            if (move != nullptr)
             {
-                FindNodeToContribute(move.node(), board, depth);
-                move.CheckSharedDone();
-            });
+                return move;
+            }
+        }
+
+        return nullptr;
     }
 
     void Perft::SendResult()
@@ -177,25 +322,57 @@ namespace m8
         auto end = std::chrono::steady_clock::now();
         auto duration = duration_cast<std::chrono::duration<double>>(end - start_);
 
-        observer_->OnPerftCompleted(root_.count(), duration.count());
+        observer_->OnPerftCompleted(root_->count(), duration.count());
     }
 
-    void Perft::RunThread()
+    void Perft::RunThread(std::size_t index)
     {
-        mutex_.lock();
+        auto& worker = *workers_[index];
 
-        if (!root_.done())
+        // The clock is only read when the thread starts and stops being idle.
+        std::optional<std::chrono::steady_clock::time_point> idle_start;
+
+        while (!done_.load(std::memory_order_acquire))
         {
-            Board board = board_;
-            FindNodeToContribute(root_, board, depth_, true);
+            auto move = worker.queue.Pop();
+            if (move == nullptr)
+            {
+                move = Steal(index);
+            }
 
-            if (root_.done())
+            if (move != nullptr)
             {
-                SendResult();
+                if (idle_start)
+                {
+                    worker.idle_time += std::chrono::steady_clock::now() - *idle_start;
+                    idle_start.reset();
+                }
+                Execute(*move, worker);
+            }
+            else
+            {
+                if (!idle_start)
+                {
+                    idle_start = std::chrono::steady_clock::now();
+                }
+                std::this_thread::yield();
             }
         }
 
-        mutex_.unlock();
+        if (idle_start)
+        {
+            worker.idle_time += std::chrono::steady_clock::now() - *idle_start;
+        }
+    }
+
+    std::chrono::steady_clock::duration Perft::idle_time() const
+    {
+        std::chrono::steady_clock::duration idle_time{0};
+        for (auto& worker : workers_)
+        {
+            idle_time += worker->idle_time;
+        }
+        return idle_time;
     }
 
     void Perft::JoinThreads()
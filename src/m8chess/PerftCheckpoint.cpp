@@ -0,0 +1,133 @@
+/// @file PerftCheckpoint.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include <algorithm>
+#include <filesystem>
+
+#include "m8chess/PerftCheckpoint.hpp"
+
+namespace m8
+{
+    namespace
+    {
+        template<typename T>
+        void WriteValue(std::ostream& stream, T value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template<typename T>
+        bool ReadValue(std::istream& stream, T& value)
+        {
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+        }
+    }
+
+    PerftCheckpoint::PerftCheckpoint(const std::string& filename, transposition::ZobristKey key, int depth)
+    {
+        std::ifstream existing(filename, std::ios::binary);
+        bool resume = existing.is_open() && existing.peek() != std::ifstream::traits_type::eof();
+        if (resume)
+        {
+            auto size = Load(existing, key, depth);
+            existing.close();
+
+            // We remove the record truncated by a crash, if any, before appending to the file.
+            std::filesystem::resize_file(filename, size);
+        }
+
+        file_.open(filename, std::ios::binary | (resume ? std::ios::app : std::ios::trunc));
+        if (!file_)
+        {
+            throw PerftCheckpointError("Unable to open the checkpoint file " + filename + ".");
+        }
+
+        if (!resume)
+        {
+            WriteValue(file_, kMagic);
+            WriteValue(file_, kVersion);
+            WriteValue(file_, key);
+            WriteValue(file_, static_cast<std::uint32_t>(depth));
+            file_.flush();
+        }
+
+        last_flush_ = std::chrono::steady_clock::now();
+    }
+
+    std::uintmax_t PerftCheckpoint::Load(std::ifstream& file, transposition::ZobristKey key, int depth)
+    {
+        std::uint32_t magic, version, file_depth;
+        transposition::ZobristKey file_key;
+
+        if (!ReadValue(file, magic) || magic != kMagic
+            || !ReadValue(file, version) || version != kVersion)
+        {
+            throw PerftCheckpointError("The file is not a perft checkpoint file.");
+        }
+
+        if (!ReadValue(file, file_key) || file_key != key
+            || !ReadValue(file, file_depth) || file_depth != static_cast<std::uint32_t>(depth))
+        {
+            throw PerftCheckpointError("The checkpoint file was created for another position or depth.");
+        }
+
+        // A record truncated by a crash is ignored, the subtree will be counted again.
+        auto size = static_cast<std::uintmax_t>(file.tellg());
+        std::uint8_t length;
+        while (ReadValue(file, length))
+        {
+            Path path(length);
+            std::uint64_t count;
+
+            bool complete = std::all_of(path.begin(), path.end(), [&file](Move& move) { return ReadValue(file, move); })
+                            && ReadValue(file, count);
+            if (!complete)
+            {
+                break;
+            }
+
+            restored_[path] = count;
+            size = static_cast<std::uintmax_t>(file.tellg());
+        }
+
+        return size;
+    }
+
+    bool PerftCheckpoint::TryGet(const Path& path, std::uint64_t& count) const
+    {
+        auto it = restored_.find(path);
+        if (it == restored_.end())
+        {
+            return false;
+        }
+
+        count = it->second;
+        return true;
+    }
+
+    void PerftCheckpoint::Record(const Path& path, std::uint64_t count)
+    {
+        if (restored_.contains(path))
+        {
+            return;
+        }
+
+        std::lock_guard lock(mutex_);
+
+        WriteValue(file_, static_cast<std::uint8_t>(path.size()));
+        for (auto move : path)
+        {
+            WriteValue(file_, move);
+        }
+        WriteValue(file_, count);
+
+        auto now = std::chrono::steady_clock::now();
+        if (kFlushInterval <= now - last_flush_)
+        {
+            file_.flush();
+            last_flush_ = now;
+        }
+    }
+}
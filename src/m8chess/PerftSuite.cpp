@@ -0,0 +1,189 @@
+/// @file PerftSuite.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "m8common/chronoHelpers.hpp"
+#include "m8common/Output.hpp"
+#include "m8common/Utils.hpp"
+
+#include "m8chess/Perft.hpp"
+
+#include "m8chess/PerftSuite.hpp"
+
+namespace m8
+{
+    namespace
+    {
+        std::string Trim(const std::string& str)
+        {
+            auto first = str.find_first_not_of(" \t\r\n");
+            if (first == std::string::npos)
+            {
+                return std::string();
+            }
+            auto last = str.find_last_not_of(" \t\r\n");
+            return str.substr(first, last - first + 1);
+        }
+    }
+
+    PerftSuitePosition PerftSuite::ParseEpdLine(const std::string& line)
+    {
+        PerftSuitePosition position;
+
+        std::istringstream in(line);
+        std::string field;
+        std::getline(in, field, ';');
+        position.fen = Trim(field);
+
+        while (std::getline(in, field, ';'))
+        {
+            std::istringstream field_stream(field);
+            std::string name;
+            std::uint64_t count;
+            if (!(field_stream >> name >> count) || name.size() < 2 || name[0] != 'D')
+            {
+                throw PerftSuiteError("Invalid perft operation \"" + Trim(field) + "\".");
+            }
+
+            int depth = 0;
+            auto [end, error] = std::from_chars(name.data() + 1, name.data() + name.size(), depth);
+            if (error != std::errc() || end != name.data() + name.size() || depth < 1)
+            {
+                throw PerftSuiteError("Invalid perft depth \"" + name.substr(1) + "\".");
+            }
+
+            position.expected.emplace_back(depth, count);
+        }
+
+        return position;
+    }
+
+    PerftSuite::PerftSuite(const std::string& filename, int max_depth, std::uint32_t threads, std::uint32_t hash_size)
+    : threads_count_(std::max(threads, 1u)),
+      hash_size_(hash_size),
+      next_test_(0)
+    {
+        std::ifstream file(filename);
+        if (!file)
+        {
+            throw PerftSuiteError("Unable to open the perft suite " + filename + ".");
+        }
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            line = Trim(line);
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            positions_.push_back(ParseEpdLine(line));
+            for (auto [depth, expected] : positions_.back().expected)
+            {
+                if (depth <= max_depth)
+                {
+                    tests_.push_back({ positions_.size() - 1, depth, expected });
+                }
+            }
+        }
+
+        // The longest tests are started first so that all the threads finish at about the
+        // same time.
+        std::ranges::sort(tests_, std::ranges::greater(), &Test::expected);
+    }
+
+    bool PerftSuite::Run()
+    {
+        results_.assign(positions_.size(), PositionResult());
+        next_test_ = 0;
+
+        // All the tests share the same hash table. The entries are keyed by position and
+        // depth so they are valid for all the tests, but a bad entry would then hide the
+        // errors of the move generator in the other tests. This is why the table is only
+        // used when asked for.
+        PerftHashTable hash_table(static_cast<std::size_t>(hash_size_) * 1024 * 1024);
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        for (std::uint32_t i = 0; i < threads_count_; ++i)
+        {
+            threads.emplace_back([this, &hash_table]() { RunTests(hash_table); });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        auto duration = std::chrono::steady_clock::now() - start;
+
+        Output out;
+        std::uint64_t nodes = 0;
+        std::uint32_t failures = 0;
+        for (std::size_t i = 0; i < positions_.size(); ++i)
+        {
+            auto& result = results_[i];
+            auto seconds = ToFSec(result.duration).count();
+
+            out << (result.failures ? "FAILED " : "OK     ")
+                << positions_[i].fen << '\t'
+                << "Nodes: " << result.nodes << '\t'
+                << "Time: " << seconds << '\t'
+                << "Nodes per second: " << AddMetricSuffix(static_cast<std::uint64_t>(0 < seconds ? result.nodes / seconds : 0), 3) << '\n';
+
+            nodes += result.nodes;
+            failures += result.failures;
+        }
+
+        auto seconds = ToFSec(duration).count();
+        out << '\n'
+            << "Threads: " << threads_count_ << '\n'
+            << "Hash: " << (hash_table.enabled() ? std::to_string(hash_size_) + " MB" : "disabled") << '\n'
+            << "Tests: " << tests_.size() << '\n'
+            << "Failures: " << failures << '\n'
+            << "Nodes: " << nodes << '\n'
+            << "Time: " << seconds << '\n'
+            << "Nodes per second: " << AddMetricSuffix(static_cast<std::uint64_t>(nodes / seconds), 3) << std::endl;
+
+        return failures == 0;
+    }
+
+    void PerftSuite::RunTests(PerftHashTable& hash_table)
+    {
+        for (auto index = next_test_++; index < tests_.size(); index = next_test_++)
+        {
+            auto& test = tests_[index];
+            auto& position = positions_[test.position];
+
+            Board board(position.fen);
+            PerftCountObserver observer;
+
+            auto start = std::chrono::steady_clock::now();
+            Perft perft(test.depth, board, &observer, hash_table, 1);
+            perft.Run();
+            auto duration = std::chrono::steady_clock::now() - start;
+
+            if (observer.count() != test.expected)
+            {
+                Output out;
+                out << "Mismatch: " << position.fen << " depth " << test.depth
+                    << " expected " << test.expected << " got " << observer.count() << std::endl;
+            }
+
+            std::lock_guard lock(mutex_);
+            auto& result = results_[test.position];
+            result.nodes += observer.count();
+            result.duration += duration;
+            result.failures += observer.count() != test.expected;
+        }
+    }
+}
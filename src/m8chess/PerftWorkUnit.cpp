@@ -0,0 +1,301 @@
+/// @file PerftWorkUnit.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include "m8common/options/Options.hpp"
+
+#include "m8chess/movegen/MoveGeneration.hpp"
+
+#include "m8chess/Perft.hpp"
+#include "m8chess/SAN.hpp"
+
+#include "m8chess/PerftWorkUnit.hpp"
+
+namespace m8
+{
+    namespace
+    {
+        Board MakePath(const std::string& fen, const PerftWorkUnit::Path& path)
+        {
+            Board board(fen);
+            for (auto move : path)
+            {
+                board.Make(move);
+            }
+            return board;
+        }
+
+        std::string RenderPath(const std::string& fen, const PerftWorkUnit::Path& path)
+        {
+            std::ostringstream out;
+            Board board(fen);
+            for (auto move : path)
+            {
+                out << ' ' << RenderSAN(move, board);
+                board.Make(move);
+            }
+            return out.str();
+        }
+
+        PerftWorkUnit::Path ParsePath(const std::string& fen, std::istream& in)
+        {
+            PerftWorkUnit::Path path;
+            Board board(fen);
+            std::string san;
+            while (in >> san)
+            {
+                auto move = ParseSAN(san, board);
+                path.push_back(move);
+                board.Make(move);
+            }
+            return path;
+        }
+
+        /// Read the header shared by the work units and the result files.
+        std::pair<std::string, int> ReadHeader(std::istream& in, const std::string& filename)
+        {
+            std::string line, keyword, fen;
+            int depth = 0;
+
+            if (!std::getline(in, line) || line.rfind("fen ", 0) != 0)
+            {
+                throw PerftWorkUnitError("Missing fen in " + filename + ".");
+            }
+            fen = line.substr(4);
+
+            if (!std::getline(in, line) || !(std::istringstream(line) >> keyword >> depth) || keyword != "depth")
+            {
+                throw PerftWorkUnitError("Missing depth in " + filename + ".");
+            }
+
+            return { fen, depth };
+        }
+    }
+
+    std::vector<std::uint64_t> PerftWorkUnit::Run() const
+    {
+        // The subtrees of a work unit often transpose, so they share the hash table.
+        PerftHashTable hash_table(static_cast<std::size_t>(options::Options::get().perft_hash) * 1024 * 1024);
+
+        std::vector<std::uint64_t> counts;
+        for (auto& path : paths_)
+        {
+            auto board = MakePath(fen_, path);
+            auto depth = depth_ - static_cast<int>(path.size());
+
+            if (depth == 0)
+            {
+                counts.push_back(1);
+                continue;
+            }
+
+            PerftCountObserver observer;
+            Perft perft(depth, board, &observer, hash_table, options::Options::get().perft_threads);
+            perft.Run();
+            counts.push_back(observer.count());
+        }
+        return counts;
+    }
+
+    std::vector<PerftWorkUnit> PerftWorkUnit::Split(const Board& board, int depth, std::size_t count)
+    {
+        if (depth < 1)
+        {
+            throw PerftWorkUnitError("The depth of a perft test must be at least 1 to split it.");
+        }
+
+        // We expand at least the root moves, so the results can be reported by root move.
+        std::vector<Path> paths = { Path() };
+        int ply = 0;
+        do
+        {
+            std::vector<Path> next_paths;
+            for (auto& path : paths)
+            {
+                MoveList moves;
+                movegen::GenerateLegalMoves(MakePath(board.fen(), path), moves);
+                for (auto move : moves)
+                {
+                    next_paths.push_back(path);
+                    next_paths.back().push_back(move.move);
+                }
+            }
+            paths = std::move(next_paths);
+            ++ply;
+        } while (!paths.empty() && paths.size() < count && ply + 1 < depth);
+
+        std::vector<PerftWorkUnit> units(std::min(std::max(count, std::size_t(1)), paths.size()),
+                                         PerftWorkUnit(board.fen(), depth));
+        for (std::size_t i = 0; i < paths.size(); ++i)
+        {
+            units[i % units.size()].AddPath(paths[i]);
+        }
+        return units;
+    }
+
+    PerftWorkUnit PerftWorkUnit::Read(const std::string& filename)
+    {
+        std::ifstream in(filename);
+        if (!in)
+        {
+            throw PerftWorkUnitError("Unable to open the work unit " + filename + ".");
+        }
+
+        auto [fen, depth] = ReadHeader(in, filename);
+        PerftWorkUnit unit(fen, depth);
+
+        std::string line, keyword;
+        while (std::getline(in, line))
+        {
+            std::istringstream line_stream(line);
+            if (line_stream >> keyword && keyword == "path")
+            {
+                unit.AddPath(ParsePath(fen, line_stream));
+            }
+        }
+
+        return unit;
+    }
+
+    void PerftWorkUnit::Write(const std::string& filename) const
+    {
+        std::ofstream out(filename);
+        out << "fen " << fen_ << '\n'
+            << "depth " << depth_ << '\n';
+
+        for (auto& path : paths_)
+        {
+            out << "path" << RenderPath(fen_, path) << '\n';
+        }
+
+        if (!out)
+        {
+            throw PerftWorkUnitError("Unable to write the work unit " + filename + ".");
+        }
+    }
+
+    void PerftWorkUnit::WriteResult(const std::string& filename, const std::vector<std::uint64_t>& counts, double time) const
+    {
+        // The results are written to a temporary file first so that a partial result is
+        // never merged.
+        auto temp_filename = filename + ".tmp";
+        {
+            std::ofstream out(temp_filename);
+            out << "fen " << fen_ << '\n'
+                << "depth " << depth_ << '\n'
+                << "time " << time << '\n';
+
+            for (std::size_t i = 0; i < paths_.size(); ++i)
+            {
+                out << "count " << counts[i] << RenderPath(fen_, paths_[i]) << '\n';
+            }
+
+            if (!out)
+            {
+                throw PerftWorkUnitError("Unable to write the result " + filename + ".");
+            }
+        }
+        std::filesystem::rename(temp_filename, filename);
+    }
+
+    void PerftWorkUnit::Merge(const std::string& directory, IPerftObserver& observer)
+    {
+        std::string fen;
+        int depth = 0;
+        double time = 0;
+        std::map<Move, std::uint64_t> root_counts;
+
+        for (auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            if (entry.path().extension() != ".unit")
+            {
+                continue;
+            }
+
+            auto result_filename = std::filesystem::path(entry.path()).replace_extension(".result").string();
+            std::ifstream in(result_filename);
+            if (!in)
+            {
+                throw PerftWorkUnitError("The work unit " + entry.path().string() + " has no result.");
+            }
+
+            auto [result_fen, result_depth] = ReadHeader(in, result_filename);
+            if (fen.empty())
+            {
+                fen = result_fen;
+                depth = result_depth;
+            }
+            else if (fen != result_fen || depth != result_depth)
+            {
+                throw PerftWorkUnitError("The result " + result_filename + " is from another perft test.");
+            }
+
+            std::string line;
+            while (std::getline(in, line))
+            {
+                std::istringstream line_stream(line);
+                std::string keyword;
+                if (!(line_stream >> keyword))
+                {
+                    continue;
+                }
+
+                // A result missing a count would give a wrong total, so the lines that
+                // can't be read are rejected instead of skipped.
+                if (keyword == "time")
+                {
+                    double unit_time;
+                    if (!(line_stream >> unit_time))
+                    {
+                        throw PerftWorkUnitError("Invalid time \"" + line + "\" in " + result_filename + ".");
+                    }
+                    time += unit_time;
+                }
+                else if (keyword == "count")
+                {
+                    std::uint64_t count;
+                    PerftWorkUnit::Path path;
+                    if (line_stream >> count)
+                    {
+                        path = ParsePath(fen, line_stream);
+                    }
+                    if (path.empty())
+                    {
+                        throw PerftWorkUnitError("Invalid count \"" + line + "\" in " + result_filename + ".");
+                    }
+                    root_counts[path.front()] += count;
+                }
+                else
+                {
+                    throw PerftWorkUnitError("Invalid line \"" + line + "\" in " + result_filename + ".");
+                }
+            }
+        }
+
+        if (fen.empty())
+        {
+            throw PerftWorkUnitError("There is no work unit in " + directory + ".");
+        }
+
+        Board board(fen);
+        MoveList moves;
+        movegen::GenerateLegalMoves(board, moves);
+
+        std::uint64_t total = 0;
+        for (auto move : moves)
+        {
+            auto count = root_counts[move.move];
+            observer.OnPartialPerftResult(RenderSAN(move.move, board), count);
+            total += count;
+        }
+
+        observer.OnPerftCompleted(total, time);
+    }
+}
@@ -4,9 +4,12 @@
 /// @brief  Contains the AlphaBeta class. This class is responsible for the search
 ///         algorithm of the chess engine.
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 #include "m8common/Signal.hpp"
+#include "m8common/options/Options.hpp"
 
 #include "m8chess/eval/Eval.hpp"
 
@@ -27,18 +30,57 @@ namespace m8::search {
           continue_(true),
           nodes_count_next_time_check_(kNodesBeforeFirstCheck),
           search_(search),
-          transposition_table_(transposition_table)
-    {}
+          transposition_table_(transposition_table),
+          null_move_min_distance_(0)
+    {
+        moves_stack_.fill(kNullMove);
+        InitializeLmrTable();
+    }
+
+    void AlphaBeta::InitializeLmrTable()
+    {
+        auto& options = options::Options::get();
+
+        lmr_min_depth_ = std::max(options.lmr_min_depth, 1);
+        lmr_full_depth_moves_ = std::max(options.lmr_full_depth_moves, 1);
+        lmr_history_divisor_ = std::max(options.lmr_history_divisor, 1);
+
+        double base = options.lmr_base / 100.0;
+        double divisor = std::max(options.lmr_divisor, 1) / 100.0;
+        for (std::size_t depth = 0; depth < kLmrTableSize; ++depth)
+        {
+            for (std::size_t move_number = 0; move_number < kLmrTableSize; ++move_number)
+            {
+                double reduction = 0;
+                if (0 < depth && 0 < move_number)
+                {
+                    reduction = base + std::log(depth) * std::log(move_number) / divisor;
+                }
+                lmr_table_[depth][move_number] = static_cast<DepthType>(std::max(reduction, 0.0));
+            }
+        }
+    }
 
-    template<bool root, bool qsearch>
+    template<NodeType node_type, bool qsearch>
     EvalType AlphaBeta::AlphaBetaSearch(EvalType alpha, EvalType beta, DepthType depth, DepthType distance, PV& pv)
     {
+        constexpr bool root = node_type == NodeType::Root;
+        constexpr bool pv_node = node_type != NodeType::NonPV;
+
         PV local_pv;
 
         pv.Clear();
 
         qsearch ? stats_.qnodes++ : stats_.nodes++;
 
+        // We check if the search was aborted. This is cheap and allows the helper threads
+        // of a parallel search to stop as soon as the main thread is done.
+        if (!qsearch && search_->is_aborted())
+        {
+            continue_ = false;
+            return 0;
+        }
+
         // We check if we need to abort the search because of time constraint
         if (!qsearch && nodes_count_next_time_check_ <= stats_.all_nodes())
         {
@@ -57,12 +99,16 @@ namespace m8::search {
         // bound better than beta we might cut the search imediately. If we find
         // a lower bound better than alpha but not better than beta we can immediately
         // raise alpha.
+        //
+        // The transposition table is shared by all the threads of the search, the entry
+        // might be overwritten while we read it. The table returns a copy of the entry
+        // and validates it's key to make sure the data belongs to the current position.
         Move tt_move = kNullMove;
         if (!qsearch && !root)
         {
             auto tt_entry = transposition_table_[board_.hash()];
             ++stats_.tt_probes;
-            if (tt_entry != nullptr)
+            if (tt_entry)
             {
                 ++stats_.tt_hits;
                 if (depth <= tt_entry->depth())
@@ -78,29 +124,34 @@ namespace m8::search {
                         && tt_eval >= beta)
                     {
                         ++stats_.tt_hits_lower;
-                        return beta;
+                        return tt_eval;
                     }
 
                     if (tt_entry->type() == transposition::EntryType::UpperBound
                         && tt_eval <= alpha)
                     {
                         ++stats_.tt_hits_upper;
-                        return alpha;
+                        return tt_eval;
                     }
                 }
-                tt_move = tt_entry->move();
+                tt_move = tt_entry->GetMove(board_);
             }
         }
 
-        // If we are in the qsearch we must evaluate the stand path option.
+        // The search is fail-soft, best_value is the best value found so far even if
+        // it is outside of the window. If we are in the qsearch we must evaluate the 
+        // stand path option.
         auto original_alpha = alpha;
+        EvalType best_value = eval::kMinEval;
+        EvalType stand_path = eval::kMinEval;
         if (qsearch)
         {
-            EvalType stand_path = eval::Evaluate(board_);
+            stand_path = eval::Evaluate(board_);
             if (stand_path >= beta)
             {
-                return beta;
+                return stand_path;
             }
+            best_value = stand_path;
             if (alpha < stand_path)
             {
                 alpha = stand_path;
@@ -112,54 +163,201 @@ namespace m8::search {
             return eval::kEvalDraw;
         }
 
+        bool in_check = !qsearch && IsInCheck(board_.side_to_move(), board_);
+
+        // Null move pruning. If the side to move can pass and a reduced search still
+        // fails high, the position is so good that a full search would most likely fail
+        // high too. We don't try a null move after another null move, when in check, or
+        // when the side to move only has pawns left because the risk of zugzwang is
+        // too high. At high depth the cutoff is verified by a reduced search to avoid
+        // the remaining zugzwang errors.
+        if (!qsearch && !pv_node
+            && kNullMoveMinDepth <= depth
+            && null_move_min_distance_ <= distance
+            && moves_stack_[distance - 1] != kNullMove
+            && !eval::IsMateEval(beta)
+            && board_.has_non_pawn_material(board_.side_to_move())
+            && !in_check
+            && beta <= eval::Evaluate(board_))
+        {
+            DepthType reduction = kNullMoveBaseReduction + depth / kNullMoveReductionDepthDivisor;
+            DepthType null_move_depth = depth - 1 - reduction;
+
+            moves_stack_[distance] = kNullMove;
+            UnmakeInfo unmake_info = board_.MakeNull();
+            EvalType null_move_value = -SearchChild<NodeType::NonPV>(-beta, -beta + 1, null_move_depth, distance + 1, local_pv);
+            board_.UnmakeNull(unmake_info);
+
+            if (!continue_)
+            {
+                return 0;
+            }
+
+            if (beta <= null_move_value)
+            {
+                // We don't trust mate scores returned by a null move search.
+                if (eval::IsMateEval(null_move_value))
+                {
+                    null_move_value = beta;
+                }
+
+                if (depth < kNullMoveVerificationDepth)
+                {
+                    return null_move_value;
+                }
+
+                auto previous_min_distance = null_move_min_distance_;
+                null_move_min_distance_ = distance + 3 * (depth - reduction) / 4;
+                EvalType verification_value = AlphaBetaSearch<NodeType::NonPV, false>(beta - 1, beta, depth - reduction, distance, local_pv);
+                null_move_min_distance_ = previous_min_distance;
+
+                if (!continue_)
+                {
+                    return 0;
+                }
+
+                if (beta <= verification_value)
+                {
+                    return null_move_value;
+                }
+            }
+        }
+
         // Evaluate all moves
         movegen::MoveGenerator generator = root     ? movegen::MoveGenerator<root, qsearch>(root_moves_)
                                          : qsearch  ? movegen::MoveGenerator<root, qsearch>(board_)
-                                         : /* else */ movegen::MoveGenerator<root, qsearch>(board_, tt_move);
+                                         : /* else */ movegen::MoveGenerator<root, qsearch>(board_, tt_move, &move_ordering_, distance, moves_stack_[distance - 1]);
         bool found_a_move = false;
+        Move best_move = kNullMove;
         std::uint16_t move_count = 0;
+        std::uint16_t legal_move_count = 0;
+        std::array<Move, kMaxQuietsTried> quiets_tried;
+        std::size_t quiets_count = 0;
         for (auto move : generator)
         {
             ++move_count;
 
+            // Delta pruning. In the qsearch, if a capture can't raise the evaluation
+            // above alpha even with a safety margin, it's not worth searching it.
+            if (qsearch
+                && GetPromoteTo(move) == kNoPiece
+                && stand_path + eval::kPieceTypeValues[static_cast<std::size_t>(eval::GamePhase::MiddleGame)][GetPieceType(GetPieceTaken(move))] + kDeltaPruningMargin <= alpha)
+            {
+                continue;
+            }
+
             if (root)
             {
                 NotifySearchMoveAtRoot(depth, 0, move_count, root_moves_.size(), stats_.nodes + stats_.qnodes, move);
             }
 
+            // The child probes the transposition table as soon as it starts. We start
+            // loading its bucket before making the move so that the memory access 
+            // overlaps with the make.
+            if (!qsearch && 1 < depth)
+            {
+                transposition_table_.Prefetch(board_.HashAfter(move));
+            }
+
             UnmakeInfo unmake_info = board_.Make(move);
+            assert(!IsInvalidCheckPosition(board_));
+
+            bool first_move = !found_a_move;
+            found_a_move = true;
+            ++legal_move_count;
+            EvalType value;
+
+            if (!qsearch)
+            {
+                assert(distance < kMaxDistance);
+                moves_stack_[distance] = move;
+            }
 
-            // If the position is invalid because the side to move is in check we must 
-            // undo the current move and continue with the next one.
-            if (IsInvalidCheckPosition(board_))
+            // Principal variation search. In PV nodes the first move is searched with
+            // the full window. The other moves are searched with a null window to 
+            // prove they are not better than the first move and are searched again
+            // with the full window only if this proof fails. In non-PV nodes the 
+            // window is already a null window.
+            if (qsearch)
+            {
+                value = -AlphaBetaSearch<NodeType::NonPV, true>(-beta, -alpha, 0, distance + 1, local_pv);
+            }
+            else if (pv_node && first_move)
             {
-                board_.Unmake(move, unmake_info);
+                value = -SearchChild<NodeType::PV>(-beta, -alpha, depth - 1, distance + 1, local_pv);
             }
             else
             {
-                found_a_move = true;
-                EvalType value;
+                // Late move reductions. Quiet moves that come late in the move 
+                // ordering are unlikely to be better than alpha and are first searched
+                // with a reduced depth. They are searched again at full depth if the 
+                // reduced search beats alpha.
+                DepthType reduction = 0;
+                if (!root
+                    && lmr_min_depth_ <= depth
+                    && lmr_full_depth_moves_ < legal_move_count
+                    && !in_check
+                    && IsQuiet(move)
+                    && !IsInCheck(board_.side_to_move(), board_))
+                {
+                    reduction = GetLateMoveReduction(depth, legal_move_count);
+                    reduction -= move_ordering_.history(move) / lmr_history_divisor_;
+
+                    if (pv_node)
+                    {
+                        --reduction;
+                    }
+
+                    auto& killers = move_ordering_.killers(distance);
+                    if (move == killers[0] || move == killers[1])
+                    {
+                        --reduction;
+                    }
+
+                    reduction = std::clamp<DepthType>(reduction, 0, depth - 2);
+                }
 
-                // If we are at depth > 1 we need to make a recursive call to the search
-                // function. If we are at depth 1 or in the qsearch we need to make a
-                // recursive call to the qsearch function.
-                if (!qsearch && depth > 1)
+                bool full_depth_search = true;
+                if (0 < reduction)
                 {
-                    // Recursive call to the search function
-                    value = -AlphaBetaSearch<false, false>(-beta, -alpha, depth - 1, distance + 1, local_pv);
+                    value = -SearchChild<NodeType::NonPV>(-alpha - 1, -alpha, depth - 1 - reduction, distance + 1, local_pv);
+                    full_depth_search = continue_ && alpha < value;
                 }
-                else
+
+                if (full_depth_search)
                 {
-                    // Call to the qsearch
-                    value = -AlphaBetaSearch<false, true>(-beta, -alpha, 0, distance + 1, local_pv);
+                    value = -SearchChild<NodeType::NonPV>(-alpha - 1, -alpha, depth - 1, distance + 1, local_pv);
                 }
-                
-                board_.Unmake(move, unmake_info);
 
-                // If we are aborting the search we need to leave immediately.
-                if (!continue_)
+                if (pv_node && continue_ && alpha < value && value < beta)
                 {
-                    return 0;
+                    value = -SearchChild<NodeType::PV>(-beta, -alpha, depth - 1, distance + 1, local_pv);
+                }
+            }
+            
+            board_.Unmake(move, unmake_info);
+
+            // If we are aborting the search we need to leave immediately.
+            if (!continue_)
+            {
+                return 0;
+            }
+
+            if (value > best_value)
+            {
+                best_value = value;
+            }
+
+            // If value is better than alpha we possibly have a new best move at this
+            // node.
+            if (value > alpha)
+            {
+                best_move = move;
+
+                // The principal variation is only collected in PV nodes.
+                if constexpr (pv_node && !qsearch)
+                {
+                    pv.Replace(move, local_pv);
                 }
 
                 // If the value of the current move is better or equal to beta we can 
@@ -168,6 +366,18 @@ namespace m8::search {
                 {
                     if (!qsearch)
                     {
+                        // A quiet move that cause a beta cutoff is likely to cause a 
+                        // cutoff in sibling positions too.
+                        if (IsQuiet(move))
+                        {
+                            move_ordering_.OnQuietBetaCutoff(move,
+                                                             root ? kNullMove : moves_stack_[distance - 1],
+                                                             quiets_tried.data(),
+                                                             quiets_count,
+                                                             depth,
+                                                             distance);
+                        }
+
                         transposition_table_.Insert(board_.hash(),
                                                     move,
                                                     transposition::EntryType::LowerBound,
@@ -175,33 +385,31 @@ namespace m8::search {
                                                     distance,
                                                     value);
                     }
-                    return beta;
+                    return value;
                 }
 
-                // If value is better than alpha we possibly have a new best move at this
-                // node.
-                if (value > alpha)
-                {
-                    alpha = value;
-                    if (!qsearch)
-                    {
-                        pv.Replace(move, local_pv);
-                    }
+                alpha = value;
 
-                    // If it is a new best move we notify the user.
-                    if (root && 1 < move_count)
-                    {
-                        NotifyNewBestMove(pv, alpha, depth, 0, stats_.nodes + stats_.qnodes);
-                    }
+                // If it is a new best move we notify the user.
+                if (root && 1 < move_count)
+                {
+                    NotifyNewBestMove(pv, alpha, depth, 0, stats_.nodes + stats_.qnodes);
                 }
             }
+
+            // We keep track of the quiet moves that did not cause a cutoff to lower
+            // their history score if another quiet move cause a cutoff.
+            if (!qsearch && IsQuiet(move) && quiets_count < kMaxQuietsTried)
+            {
+                quiets_tried[quiets_count++] = move;
+            }
         }
 
         // If we have not found any legal move during the search we are either checkmate 
         // or stalemate. We need to return a value accordingly.
         if (!qsearch && !found_a_move)
         {
-            if (IsInCheck(board_.side_to_move(), board_))
+            if (in_check)
             {
                 assert(IsMat(board_));
                 return eval::GetMateValue(distance);
@@ -215,25 +423,25 @@ namespace m8::search {
         // alpha) or an exact score.
         if (!qsearch)
         {
-            auto type_tt_entry = (alpha == original_alpha ? transposition::EntryType::UpperBound
-                                                          : transposition::EntryType::Exact);
+            auto type_tt_entry = (best_value <= original_alpha ? transposition::EntryType::UpperBound
+                                                               : transposition::EntryType::Exact);
             transposition_table_.Insert(board_.hash(),
-                                        (pv.any() ? pv.first() : kNullMove),
+                                        best_move,
                                         type_tt_entry,
                                         depth,
                                         distance,
-                                        alpha);
+                                        best_value);
         }
-        return alpha;
+        return best_value;
     }
 
-    SearchResult AlphaBeta::Start(DepthType depth)
+    SearchResult AlphaBeta::Start(DepthType depth, EvalType alpha, EvalType beta)
     {
         PV pv;
 
         NotifySearchStarted();
 
-        auto value = AlphaBetaSearch<true, false>(eval::kMinEval, eval::kMaxEval, depth, 0, pv);
+        auto value = AlphaBetaSearch<NodeType::Root, false>(alpha, beta, depth, 0, pv);
 
         auto result_type = continue_ ? ResultType::Complete
                                      : (pv.any() ? ResultType::Partial
@@ -5,6 +5,8 @@
 
 #include <algorithm>
 
+#include "m8common/options/Options.hpp"
+#include "m8common/logging.hpp"
 #include "m8common/Signal.hpp"
 
 #include "m8chess/movegen/MoveGenerator.hpp"
@@ -26,12 +28,124 @@ namespace m8::search {
         }
     }
 
+    SearchResult IterativeDeepening::AspirationSearch(AlphaBeta& alpha_beta, MoveList& root_moves, DepthType depth, const SearchResult& previous_result)
+    {
+        // At low depth the value changes too much from one iteration to the next and 
+        // we can't center the window on a mate value.
+        if (depth < kAspirationMinDepth
+            || previous_result.type_ != ResultType::Complete
+            || eval::IsMateEval(previous_result.value_))
+        {
+            return alpha_beta.Start(depth);
+        }
+
+        int delta = kAspirationWindow;
+        EvalType alpha = std::max(previous_result.value_ - delta, static_cast<int>(eval::kMinEval));
+        EvalType beta  = std::min(previous_result.value_ + delta, static_cast<int>(eval::kMaxEval));
+
+        while (true)
+        {
+            SearchResult result = alpha_beta.Start(depth, alpha, beta);
+            if (result.type_ != ResultType::Complete)
+            {
+                return result;
+            }
+
+            if (result.value_ <= alpha)
+            {
+                alpha = std::max(alpha - delta, static_cast<int>(eval::kMinEval));
+            }
+            else if (beta <= result.value_)
+            {
+                // The move that failed high is probably the best move, we search it first
+                // in the next search.
+                root_moves.PullFront(result.pv_.first());
+                beta = std::min(beta + delta, static_cast<int>(eval::kMaxEval));
+            }
+            else
+            {
+                return result;
+            }
+
+            delta *= 2;
+        }
+    }
+
+    std::vector<std::unique_ptr<SearchHelper>> IterativeDeepening::StartHelpers(std::shared_ptr<Search> search, const MoveList& root_moves)
+    {
+        std::vector<std::unique_ptr<SearchHelper>> helpers;
+
+        auto threads = std::max<std::uint32_t>(options::Options::get().threads, 1);
+        for (std::size_t index = 0; index < threads - 1; ++index)
+        {
+            // The helpers are not bound by the time manager of the main search, they 
+            // search until they are stopped by the main thread.
+            auto time_manager = std::make_unique<TimeManager>(std::nullopt, std::nullopt, std::nullopt, std::nullopt, true);
+            auto helper = std::make_unique<SearchHelper>();
+            helper->search = std::make_shared<Search>(search->board(), std::move(time_manager), search->max_depth());
+            helper->thread = std::thread(&IterativeDeepening::RunHelper, this, std::ref(*helper), root_moves, index);
+            helpers.push_back(std::move(helper));
+        }
+
+        return helpers;
+    }
+
+    SearchStats IterativeDeepening::StopHelpers(std::vector<std::unique_ptr<SearchHelper>>& helpers)
+    {
+        for (auto& helper : helpers)
+        {
+            helper->search->Abort();
+        }
+
+        SearchStats stats;
+        for (auto& helper : helpers)
+        {
+            helper->thread.join();
+            stats += helper->stats;
+        }
+
+        return stats;
+    }
+
+    void IterativeDeepening::RunHelper(SearchHelper& helper, MoveList root_moves, std::size_t index)
+    {
+        M8_LOG_SCOPE_THREAD();
+
+        helper.search->time_manager().OnSearchStarted();
+
+        AlphaBeta alpha_beta(helper.search, transposition_table_, root_moves);
+
+        // Half of the helpers search one ply deeper than the others. This way the 
+        // threads are not all searching the same tree at the same time and the deeper
+        // helpers fill the transposition table with results the main thread will need
+        // in it's next iteration.
+        SearchResult last_result;
+        DepthType current_depth = 1 + index % 2;
+        while(!helper.search->is_aborted()
+                && current_depth <= helper.search->max_depth())
+        {
+            SearchResult result = AspirationSearch(alpha_beta, root_moves, current_depth, last_result);
+            if (result.type_ != ResultType::None)
+            {
+                root_moves.PullFront(result.pv_.first());
+            }
+
+            last_result = result;
+            helper.stats = result.stats_;
+            ++current_depth;
+        }
+    }
+
     SearchResult IterativeDeepening::Start(std::shared_ptr<Search> search)
     {
         // Generate the root moves
         MoveList root_moves;
         GetRootMoves(search->board(), root_moves);
 
+        // Start the helpers threads of the Lazy SMP search if we use more than one 
+        // thread.
+        auto helpers = StartHelpers(search, root_moves);
+
         AlphaBeta alpha_beta(search, transposition_table_, root_moves);
         alpha_beta.Attach(this);
 
@@ -46,7 +160,7 @@ namespace m8::search {
                 && !signal_received.load())
         {
             NotifyIterationStarted();
-            SearchResult result = alpha_beta.Start(current_depth);
+            SearchResult result = AspirationSearch(alpha_beta, root_moves, current_depth, last_result);
             if (result.type_ == ResultType::Complete)
             {
                 NotifyIterationCompleted(result.pv_,
@@ -73,6 +187,9 @@ namespace m8::search {
             ++current_depth;
         }
 
+        // The statistics of the search include the nodes searched by all the threads.
+        last_result.stats_ += StopHelpers(helpers);
+
         NotifySearchCompleted(last_result.pv_, 0, last_result.stats_);
 
         return last_result;
@@ -15,10 +15,11 @@ namespace m8 { namespace search
 {
     Searcher::Searcher(transposition::TranspositionTable& transposition_table)
      : destroying_(false),
-       search_thread_(&Searcher::RunSearchThread, this),   
+       search_pending_(false),
        state_(SearchState::Ready),
        transposition_table_(transposition_table),
-       iterative_deepening_(transposition_table)
+       iterative_deepening_(transposition_table),
+       search_thread_(&Searcher::RunSearchThread, this)
     {
         iterative_deepening_.Attach(this);
     }
@@ -58,6 +59,7 @@ namespace m8 { namespace search
             state_          = SearchState::Searching;
             current_search_ = search;
             start_time_     = std::chrono::steady_clock::now();
+            search_pending_ = true;
 
             Attach(&current_search_->time_manager());
         }
@@ -127,12 +129,13 @@ namespace m8 { namespace search
             std::shared_ptr<Search> search_to_run;
             {
                 std::unique_lock lock(mutex_);
-                condition_variable_.wait(lock);
+                condition_variable_.wait(lock, [this] { return destroying_ || search_pending_; });
 
                 if (!destroying_ && current_search_)
                 {
                     search_to_run = current_search_;
                 }
+                search_pending_ = false;
             }
 
             if (search_to_run)
@@ -0,0 +1,105 @@
+/// @file LargePages.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#   include <sys/mman.h>
+#endif
+
+#include "m8common/LargePages.hpp"
+
+namespace m8
+{
+    namespace
+    {
+        const std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+        std::size_t RoundUp(std::size_t size, std::size_t alignment)
+        {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+#if defined(__linux__)
+        /// madvise succeeds even if the transparent huge pages are disabled, so we check
+        /// the configuration of the kernel to report the right mode.
+        bool TransparentHugePagesEnabled()
+        {
+            std::ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+            std::string config;
+            return std::getline(in, config) && config.find("[never]") == std::string::npos;
+        }
+#endif
+    }
+
+    LargePageAllocation AllocateLargePages(std::size_t size, std::size_t alignment)
+    {
+        LargePageAllocation allocation;
+
+#if defined(__linux__)
+        if (kHugePageSize <= size)
+        {
+            auto huge_size = RoundUp(size, kHugePageSize);
+
+            void* data = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (data != MAP_FAILED)
+            {
+                return { data, huge_size, PageMode::Huge };
+            }
+
+            if (TransparentHugePagesEnabled())
+            {
+                data = std::aligned_alloc(kHugePageSize, huge_size);
+                if (data != nullptr)
+                {
+                    if (madvise(data, huge_size, MADV_HUGEPAGE) == 0)
+                    {
+                        return { data, huge_size, PageMode::Transparent };
+                    }
+                    std::free(data);
+                }
+            }
+        }
+#endif
+
+        allocation.size = RoundUp(size, alignment);
+        allocation.data = std::aligned_alloc(alignment, allocation.size);
+        return allocation;
+    }
+
+    void FreeLargePages(const LargePageAllocation& allocation)
+    {
+        if (allocation.data == nullptr)
+        {
+            return;
+        }
+
+#if defined(__linux__)
+        if (allocation.mode == PageMode::Huge)
+        {
+            munmap(allocation.data, allocation.size);
+            return;
+        }
+#endif
+
+        std::free(allocation.data);
+    }
+
+    std::string_view ToString(PageMode mode)
+    {
+        switch (mode)
+        {
+        case PageMode::Huge:
+            return "huge pages";
+        case PageMode::Transparent:
+            return "transparent huge pages";
+        default:
+            return "normal pages";
+        }
+    }
+}
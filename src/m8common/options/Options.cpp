@@ -26,6 +26,36 @@ namespace m8::options
                                                     "Define the hashtable size in Mb.",
                                                     this->tt_size));
 
+        modifiable_options.emplace("Threads",
+            std::make_unique<TypedModifiableOption<std::uint32_t>>("Threads",
+                                                    "Define the number of threads used by the search.",
+                                                    this->threads));
+
+        modifiable_options.emplace("LmrBase",
+            std::make_unique<TypedModifiableOption<std::int32_t>>("LmrBase",
+                                                    "Base reduction of the late move reductions in hundredth of ply.",
+                                                    this->lmr_base));
+
+        modifiable_options.emplace("LmrDivisor",
+            std::make_unique<TypedModifiableOption<std::int32_t>>("LmrDivisor",
+                                                    "Divisor of ln(depth) * ln(move number) in the late move reductions in hundredth.",
+                                                    this->lmr_divisor));
+
+        modifiable_options.emplace("LmrMinDepth",
+            std::make_unique<TypedModifiableOption<std::int32_t>>("LmrMinDepth",
+                                                    "Minimum depth at which the late move reductions are used.",
+                                                    this->lmr_min_depth));
+
+        modifiable_options.emplace("LmrFullDepthMoves",
+            std::make_unique<TypedModifiableOption<std::int32_t>>("LmrFullDepthMoves",
+                                                    "Number of moves searched at full depth before the late move reductions are used.",
+                                                    this->lmr_full_depth_moves));
+
+        modifiable_options.emplace("LmrHistoryDivisor",
+            std::make_unique<TypedModifiableOption<std::int32_t>>("LmrHistoryDivisor",
+                                                    "History score that decrease the late move reduction by one ply.",
+                                                    this->lmr_history_divisor));
+
         modifiable_options.emplace("UCI_Chess960",
             std::make_unique<TypedModifiableOption<bool>>("UCI_Chess960",
                                                     "Indicate if we play a Chess960 game.",
@@ -96,6 +126,15 @@ namespace m8::options
     //     }
     // }
 
+    void ReadLateMoveReductions(pt::ptree& tree, Options& options)
+    {
+        TryReadOption<std::int32_t>(tree, "lmr.base",              options.lmr_base);
+        TryReadOption<std::int32_t>(tree, "lmr.divisor",           options.lmr_divisor);
+        TryReadOption<std::int32_t>(tree, "lmr.min-depth",         options.lmr_min_depth);
+        TryReadOption<std::int32_t>(tree, "lmr.full-depth-moves",  options.lmr_full_depth_moves);
+        TryReadOption<std::int32_t>(tree, "lmr.history-divisor",   options.lmr_history_divisor);
+    }
+
     void ReadPiecesValues(pt::ptree& tree, PiecesValues& values)
     {
         TryReadOption<std::int16_t>(tree, "pawn",   values.pawn);
@@ -157,11 +196,23 @@ namespace m8::options
             options.perft_threads = boost::lexical_cast<std::uint32_t>(temp);
         }
 
+        if (TryReadOption<std::string>(tree, "perft-hash", temp))
+        {
+            options.perft_hash = boost::lexical_cast<std::uint32_t>(temp);
+        }
+
+        if (TryReadOption<std::string>(tree, "threads", temp))
+        {
+            options.threads = boost::lexical_cast<std::uint32_t>(temp);
+        }
+
         if (TryReadOption<std::string>(tree, "tt-size", temp))
         {
             options.tt_size = boost::lexical_cast<size_t>(temp);
         }
 
+        ReadLateMoveReductions(tree, options);
+
         ReadPiecesValues(tree, options);
         ReadPieceSquareTable(tree, options);
     }
@@ -176,7 +227,7 @@ namespace m8::options
             ("max-log-severity", po::value<m8::severity_level>(&options.max_log_severity),
              "Define the maximum log severity level (fatal, error, warning, info, output, input, debug, trace).")
             ("tt-size", po::value<size_t>(&options.tt_size),
-             "Transposition table size in megabytes (must be a power of two).");
+             "Transposition table size in megabytes.");
             
         return desc;
     }
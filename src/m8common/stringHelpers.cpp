@@ -4,6 +4,7 @@
 /// @brief Contains implementations of string helpers
 
 #include <sstream>
+#include <stdexcept>
 
 #include "m8common/stringHelpers.hpp"
 
@@ -19,4 +20,39 @@ namespace m8
         }
         return result;
     }
+
+    std::vector<std::uint32_t> ParseNumberList(const std::string& str)
+    {
+        std::vector<std::uint32_t> result;
+        std::istringstream iss(str);
+        std::string token;
+        while (std::getline(iss, token, ','))
+        {
+            std::size_t end = 0;
+            unsigned long number = 0;
+            try
+            {
+                number = std::stoul(token, &end);
+            }
+            catch (const std::logic_error&)
+            {
+                end = 0;
+            }
+
+            if (end == 0 || end != token.size() || number == 0)
+            {
+                throw std::invalid_argument("Invalid number \"" + token + "\" in the list \"" + str + "\".");
+            }
+            result.push_back(static_cast<std::uint32_t>(number));
+        }
+        return result;
+    }
+
+    std::vector<std::uint32_t> ParseThreadCounts(const std::string& str)
+    {
+        auto result = ParseNumberList(str);
+        std::erase(result, 1u);
+        result.insert(result.begin(), 1);
+        return result;
+    }
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 
+#include "m8chess/movegen/MoveGeneration.hpp"
 #include "m8chess/Board.hpp"
 #include "m8chess/Move.hpp"
 
@@ -617,6 +618,42 @@ TEST_CASE("Unmake__pawn_promotion__board_is_restored")
     REQUIRE(board.side_to_move() == kBlack);
 }
 
+TEST_CASE("MakeNull__position_with_en_passant__side_to_move_switched_and_en_passant_cleared")
+{
+    Board board("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3");
+
+    board.MakeNull();
+
+    REQUIRE(board.side_to_move() == kBlack);
+    REQUIRE(board.colmn_enpas() == kInvalColmn);
+    REQUIRE(board.half_move_clock() == 0);
+    REQUIRE(board[kE5] == kWhitePawn);
+    REQUIRE(board[kF5] == kBlackPawn);
+}
+
+TEST_CASE("UnmakeNull__position_with_en_passant__position_is_restored")
+{
+    Board board("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 3 3");
+    auto original_hash = board.hash();
+
+    auto unmake_info = board.MakeNull();
+    board.UnmakeNull(unmake_info);
+
+    REQUIRE(board.side_to_move() == kWhite);
+    REQUIRE(board.colmn_enpas() == kColmnF);
+    REQUIRE(board.half_move_clock() == 3);
+    REQUIRE(board.full_move_clock() == 3);
+    REQUIRE(board.hash() == original_hash);
+}
+
+TEST_CASE("has_non_pawn_material__only_pawns_and_king__returns_false")
+{
+    Board board("4k3/pp6/8/8/8/8/5PP1/4K1N1 w - - 0 1");
+
+    REQUIRE(board.has_non_pawn_material(kWhite));
+    REQUIRE_FALSE(board.has_non_pawn_material(kBlack));
+}
+
 TEST_CASE("Test that hash value is correct after modifications to the position")
 {
     Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -");
@@ -644,8 +681,45 @@ TEST_CASE("Test that hash value is correct after modifications to the position")
         expected_fen = "r3k2r/p1ppqpb1/Bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPB1PPP/R3K2R b KQkq - 0 1";
     }
 
+    SECTION("Null move")
+    {
+        board.MakeNull();
+        expected_fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq -";
+    }
+
 
     Board expected(expected_fen);
     REQUIRE(expected.hash() == board.hash());
 }
 
+TEST_CASE("HashAfter returns the hash of the position after the move")
+{
+    // Castling, rook captures, promotions, en passant and Chess960 castling.
+    auto fen = GENERATE(as<std::string>{},
+                        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
+                        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                        "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+                        "1rqbkrbn/1ppppp1p/1n6/p1N3p1/8/2P4P/PP1PPPP1/1RQBKRBN w FBfb - 0 9");
+    Board board(fen);
+
+    MoveList moves;
+    movegen::GenerateLegalMoves(board, moves);
+    for (auto move : moves)
+    {
+        auto expected = board.HashAfter(move.move);
+        auto unmake_info = board.Make(move.move);
+
+        MoveList replies;
+        movegen::GenerateLegalMoves(board, replies);
+        for (auto reply : replies)
+        {
+            auto reply_expected = board.HashAfter(reply.move);
+            auto reply_unmake_info = board.Make(reply.move);
+            REQUIRE(reply_expected == board.hash());
+            board.Unmake(reply.move, reply_unmake_info);
+        }
+
+        REQUIRE(expected == board.hash());
+        board.Unmake(move.move, unmake_info);
+    }
+}
@@ -0,0 +1,62 @@
+/// @file CompactMove_tests.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include <algorithm>
+#include <string>
+
+#include "catch2/catch_all.hpp"
+
+#include "m8chess/movegen/MoveGeneration.hpp"
+
+#include "m8chess/CompactMove.hpp"
+#include "m8chess/MoveLegality.hpp"
+
+using namespace m8;
+using namespace m8::movegen;
+
+TEST_CASE("FromCompactMove_LegalMove_ReturnsSameMove")
+{
+    std::string fen;
+
+    SECTION("Starting position")   { fen = kStartingPositionFEN; }
+    SECTION("Castling")            { fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"; }
+    SECTION("Promotions")          { fen = "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1"; }
+    SECTION("Prise en passant")    { fen = "8/8/3p4/KPp4r/1R3p1k/8/4P1P1/8 w - c6 0 1"; }
+    SECTION("Chess960 castling")   { fen = "1rk1r3/8/8/8/8/8/8/1RK1R3 w BEbe - 0 1"; }
+
+    Board board(fen);
+    MoveList moves;
+    GenerateLegalMoves(board, moves);
+
+    for (auto pair : moves)
+    {
+        REQUIRE(pair.move == FromCompactMove(ToCompactMove(pair.move), board));
+    }
+}
+
+TEST_CASE("FromCompactMove_AnyCompactMove_OnlyLegalMovesAccepted")
+{
+    std::string fen;
+
+    SECTION("Castling")          { fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"; }
+    SECTION("Promotions")        { fen = "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1"; }
+    SECTION("Chess960 castling") { fen = "4k3/8/8/8/8/8/8/1RKB4 w B - 0 1"; }
+
+    Board board(fen);
+    MoveList moves;
+    GenerateLegalMoves(board, moves);
+
+    // A compact move can come from another position after a collision in the
+    // transposition table. Once validated it must be one of the legal moves.
+    for (std::uint32_t code = 0; code <= 0xFFFF; ++code)
+    {
+        auto move = FromCompactMove(static_cast<CompactMove>(code), board);
+        if (move != kNullMove && IsPseudoLegal(board, move) && IsLegal(board, move))
+        {
+            REQUIRE(moves.end() != std::find_if(moves.begin(), moves.end(),
+                                                [move](const MoveEvalPair& pair) { return pair.move == move; }));
+        }
+    }
+}
@@ -0,0 +1,39 @@
+/// @file LargePages_tests.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include "catch2/catch_all.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include "m8common/LargePages.hpp"
+
+using namespace m8;
+
+TEST_CASE("AllocateLargePages returns an aligned block of at least the size requested")
+{
+    auto size = GENERATE(std::size_t(64 * 1024), std::size_t(3 * 1024 * 1024), std::size_t(16 * 1024 * 1024));
+
+    auto allocation = AllocateLargePages(size, 64);
+
+    REQUIRE(allocation.data != nullptr);
+    REQUIRE(size <= allocation.size);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(allocation.data) % 64 == 0);
+
+    // The whole block must be writable, whatever the type of pages backing it.
+    std::memset(allocation.data, 0xAB, allocation.size);
+    REQUIRE(static_cast<unsigned char*>(allocation.data)[allocation.size - 1] == 0xAB);
+
+    FreeLargePages(allocation);
+}
+
+TEST_CASE("Small blocks are backed by normal pages")
+{
+    auto allocation = AllocateLargePages(64 * 1024, 64);
+
+    REQUIRE(allocation.mode == PageMode::Normal);
+
+    FreeLargePages(allocation);
+}
@@ -10,6 +10,7 @@
 #include "m8chess/movegen/MoveGeneration.hpp"
 
 #include "m8chess/Board.hpp"
+#include "m8chess/Checkmate.hpp"
 #include "m8chess/Move.hpp"
 #include "m8common/Utils.hpp"
 
@@ -565,4 +566,119 @@ TEST_CASE("GenerateCastlingMoves__positions_traveled_by_rook_occupied__castling_
 
     REQUIRE(5 == moves.size());
     REQUIRE(!Contains(unexpected_move, moves));
-}
\ No newline at end of file
+}
+
+namespace
+{
+    /// Generate the legal moves by making the pseudo-legal moves and verifying that the
+    /// king is not left in check.
+    MoveList GenerateFilteredPseudoLegalMoves(Board& board)
+    {
+        MoveList pseudo_legal_moves;
+        MoveList moves;
+        GenerateAllMoves(board, pseudo_legal_moves);
+
+        for (auto pair : pseudo_legal_moves)
+        {
+            UnmakeInfo unmake_info = board.Make(pair.move);
+            if (!IsInCheck(OpposColor(board.side_to_move()), board))
+            {
+                moves.Push(pair.move);
+            }
+            board.Unmake(pair.move, unmake_info);
+        }
+
+        return moves;
+    }
+}
+
+TEST_CASE("GenerateLegalMoves__different_positions__same_moves_as_filtered_pseudo_legal_moves")
+{
+    auto fen = GENERATE(as<std::string>{},
+                        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
+                        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -",
+                        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+                        "8/8/8/K2pP2r/8/8/8/7k w - d6 0 1",
+                        "4k3/8/8/8/8/8/3q4/R3K2R w KQ - 0 1",
+                        "4k3/8/5n2/8/8/8/4r3/4K3 w - - 0 1");
+    Board board(fen);
+    MoveList moves;
+
+    GenerateLegalMoves(board, moves);
+    MoveList expected_moves = GenerateFilteredPseudoLegalMoves(board);
+
+    REQUIRE(expected_moves.size() == moves.size());
+    for (auto pair : expected_moves)
+    {
+        REQUIRE(Contains(pair.move, moves));
+    }
+}
+
+TEST_CASE("GenerateLegalMoves__double_check__only_king_moves")
+{
+    Board board("4k3/8/8/8/1b6/8/4r3/R3K2R w KQ - 0 1");
+    MoveList moves;
+
+    GenerateLegalMoves(board, moves);
+
+    REQUIRE(moves.any());
+    for (auto pair : moves)
+    {
+        REQUIRE(GetPiece(pair.move) == kWhiteKing);
+        REQUIRE(GetCastling(pair.move) == kNoCastling);
+    }
+}
+
+TEST_CASE("GenerateLegalMoves__pinned_rook__moves_along_the_pin_only")
+{
+    Board board("4r2k/8/8/8/8/8/4R3/4K3 w - - 0 1");
+    MoveList moves;
+
+    std::vector<Move> expected_moves =
+    {
+        NewMove(kE2, kE3, kWhiteRook),
+        NewMove(kE2, kE4, kWhiteRook),
+        NewMove(kE2, kE5, kWhiteRook),
+        NewMove(kE2, kE6, kWhiteRook),
+        NewMove(kE2, kE7, kWhiteRook),
+        NewMove(kE2, kE8, kWhiteRook, kBlackRook),
+        NewMove(kE1, kD1, kWhiteKing),
+        NewMove(kE1, kF1, kWhiteKing),
+        NewMove(kE1, kD2, kWhiteKing),
+        NewMove(kE1, kF2, kWhiteKing)
+    };
+
+    GenerateLegalMoves(board, moves);
+
+    RequireSameMoves(expected_moves, moves);
+}
+
+TEST_CASE("GenerateLegalMoves__prise_en_passant_expose_king__prise_en_passant_not_generated")
+{
+    Board board("8/8/8/K2pP2r/8/8/8/7k w - d6 0 1");
+    MoveList moves;
+
+    Move unexpected_move = NewMove(kE5, kD6, kWhitePawn, kBlackPawn);
+
+    GenerateLegalMoves(board, moves);
+
+    REQUIRE(!Contains(unexpected_move, moves));
+}
+
+TEST_CASE("GenerateLegalCaptures__in_check__only_capture_of_the_checker")
+{
+    Board board("4k3/8/8/8/8/2N5/4r3/4K3 w - - 0 1");
+    MoveList moves;
+
+    std::vector<Move> expected_moves =
+    {
+        NewMove(kC3, kE2, kWhiteKnight, kBlackRook),
+        NewMove(kE1, kE2, kWhiteKing, kBlackRook)
+    };
+
+    GenerateLegalCaptures(board, moves);
+
+    RequireSameMoves(expected_moves, moves);
+}
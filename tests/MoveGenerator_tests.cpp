@@ -0,0 +1,118 @@
+/// @file   MoveGenerator_tests.cpp
+/// @author Mathieu Pagé
+/// @date   October 2026
+/// @brief  Contains tests of the MoveGenerator class.
+
+#include <algorithm>
+#include <vector>
+
+#include "catch2/catch_all.hpp"
+
+#include "m8chess/movegen/MoveGenerator.hpp"
+#include "m8chess/movegen/MoveOrdering.hpp"
+#include "m8chess/movegen/See.hpp"
+
+#include "m8chess/Board.hpp"
+#include "m8chess/Move.hpp"
+
+using namespace m8;
+using namespace m8::movegen;
+
+namespace
+{
+    const std::string kKiwipeteFEN = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -";
+
+    std::vector<Move> GenerateWithGenerator(Board& board, const MoveOrdering& ordering, DepthType distance, Move previous_move)
+    {
+        std::vector<Move> moves;
+        MoveGenerator<false, false> generator(board, kNullMove, &ordering, distance, previous_move);
+        for (auto move : generator)
+        {
+            moves.push_back(move);
+        }
+        return moves;
+    }
+
+    std::size_t CountCaptures(const Board& board, bool losing)
+    {
+        MoveList captures;
+        GenerateAllCaptures(board, captures);
+        return std::count_if(captures.begin(), captures.end(), [&board, losing](MoveEvalPair pair) { return (See(board, pair.move) < 0) == losing; });
+    }
+
+    std::size_t CountAllMoves(const Board& board)
+    {
+        MoveList moves;
+        GenerateAllMoves(board, moves);
+        return moves.size();
+    }
+
+    void RequireNoDuplicates(std::vector<Move> moves)
+    {
+        std::sort(moves.begin(), moves.end());
+        REQUIRE(std::adjacent_find(moves.begin(), moves.end()) == moves.end());
+    }
+}
+
+TEST_CASE("MoveGenerator__killer_moves__killers_distributed_after_good_captures")
+{
+    Board board(kKiwipeteFEN);
+    MoveOrdering ordering;
+    Move first_killer = NewMove(kA2, kA3, kWhitePawn);
+    Move second_killer = NewMove(kF3, kG3, kWhiteQueen);
+    ordering.OnQuietBetaCutoff(first_killer, kNullMove, nullptr, 0, 1, 2);
+    ordering.OnQuietBetaCutoff(second_killer, kNullMove, nullptr, 0, 1, 2);
+    auto captures_count = CountCaptures(board, false);
+
+    auto moves = GenerateWithGenerator(board, ordering, 2, kNullMove);
+
+    REQUIRE(moves.size() == CountAllMoves(board));
+    RequireNoDuplicates(moves);
+    REQUIRE(moves[captures_count] == second_killer);
+    REQUIRE(moves[captures_count + 1] == first_killer);
+}
+
+TEST_CASE("MoveGenerator__killer_move_to_occupied_square__killer_skipped")
+{
+    Board board(kKiwipeteFEN);
+    MoveOrdering ordering;
+    Move killer = NewMove(kF3, kE2, kWhiteQueen);
+    ordering.OnQuietBetaCutoff(killer, kNullMove, nullptr, 0, 1, 2);
+
+    auto moves = GenerateWithGenerator(board, ordering, 2, kNullMove);
+
+    REQUIRE(moves.size() == CountAllMoves(board));
+    REQUIRE(std::find(moves.begin(), moves.end(), killer) == moves.end());
+}
+
+TEST_CASE("MoveGenerator__counter_move__counter_move_distributed_after_good_captures")
+{
+    Board board(kKiwipeteFEN);
+    MoveOrdering ordering;
+    Move previous_move = NewMove(kB6, kC4, kBlackKnight);
+    Move counter_move = NewMove(kE2, kD3, kWhiteBishop);
+    ordering.OnQuietBetaCutoff(counter_move, previous_move, nullptr, 0, 1, 5);
+
+    auto moves = GenerateWithGenerator(board, ordering, 2, previous_move);
+
+    REQUIRE(moves.size() == CountAllMoves(board));
+    RequireNoDuplicates(moves);
+    REQUIRE(moves[CountCaptures(board, false)] == counter_move);
+}
+
+TEST_CASE("MoveGenerator__history__quiet_moves_ordered_by_history")
+{
+    Board board(kKiwipeteFEN);
+    MoveOrdering ordering;
+    Move good_move = NewMove(kC3, kB5, kWhiteKnight);
+    Move bad_move = NewMove(kG2, kG3, kWhitePawn);
+    ordering.OnQuietBetaCutoff(good_move, kNullMove, &bad_move, 1, 4, 5);
+
+    auto moves = GenerateWithGenerator(board, ordering, 2, kNullMove);
+
+    REQUIRE(moves.size() == CountAllMoves(board));
+    REQUIRE(0 < ordering.history(good_move));
+    REQUIRE(ordering.history(bad_move) < 0);
+    REQUIRE(moves[CountCaptures(board, false)] == good_move);
+    REQUIRE(moves[moves.size() - CountCaptures(board, true) - 1] == bad_move);
+}
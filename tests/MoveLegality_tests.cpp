@@ -5,6 +5,7 @@
 
 #include "catch2/catch_all.hpp"
 
+#include "m8chess/Checkmate.hpp"
 #include "m8chess/MoveLegality.hpp"
 
 using namespace m8;
@@ -64,6 +65,21 @@ TEST_CASE("IsPseudoLegal_WrongPieceOnTarget_ReturnsFalse")
     REQUIRE(expected == actual);
 }
 
+TEST_CASE("IsPseudoLegal_QuietMoveToOccupiedSquare_ReturnsFalse")
+{
+    Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - ");
+    bool expected = false;
+    Move move = kNullMove;
+
+    SECTION("Square occupied by a piece of the same color") { move = NewMove(kF3, kE2, kWhiteQueen); }
+    SECTION("Square occupied by a piece of the opponent")    { move = NewMove(kE5, kF7, kWhiteKnight); }
+    SECTION("Pawn pushed on an occupied square")            { move = NewMove(kE4, kE5, kWhitePawn); }
+
+    bool actual = IsPseudoLegal(board, move);
+
+    REQUIRE(expected == actual);
+}
+
 TEST_CASE("IsPseudoLegal_IllegalCastling_ReturnsFalse")
 {
     Board board(kStartingPositionFEN);
@@ -135,6 +151,17 @@ TEST_CASE("IsPseudoLegal_CastlingWhileTravelSquareOccupied_ReturnsFalse")
     REQUIRE(expected == actual);
 }
 
+TEST_CASE("IsPseudoLegal_Chess960CastlingWhileFinalSquareOccupied_ReturnsFalse")
+{
+    Board board("4k3/8/8/8/8/8/8/1RKB4 w B - 0 1");
+    Move move = NewMove(kC1, kC1, kWhiteKing, kNoPiece, kNoPiece, kQueenSideCastle);
+    bool expected = false;
+
+    bool actual = IsPseudoLegal(board, move);
+
+    REQUIRE(expected == actual);
+}
+
 TEST_CASE("IsPseudoLegal_PawnTwoMoveWhileSquareInFrontOccupied_ReturnsFalse")
 {
     Board board("4k3/8/8/8/8/5p2/5P2/4K3 w - - 0 1");
@@ -319,4 +346,37 @@ TEST_CASE("IsPseudoLegal_LegalFischerCastling_ReturnsTrue")
     bool actual = IsPseudoLegal(board, move);
 
     REQUIRE(expected == actual);
-}
\ No newline at end of file
+}
+
+TEST_CASE("IsLegal_PseudoLegalMoves_SameResultAsMakingTheMove")
+{
+    auto fen = GENERATE(as<std::string>{},
+                        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
+                        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -",
+                        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                        "8/8/8/K2pP2r/8/8/8/7k w - d6 0 1",
+                        "4k3/8/5n2/8/8/8/4r3/4K3 w - - 0 1");
+    Board board(fen);
+    MoveList moves;
+    movegen::GenerateAllMoves(board, moves);
+
+    for (auto pair : moves)
+    {
+        UnmakeInfo unmake_info = board.Make(pair.move);
+        bool expected = !IsInvalidCheckPosition(board);
+        board.Unmake(pair.move, unmake_info);
+
+        bool actual = IsLegal(board, pair.move);
+
+        REQUIRE(expected == actual);
+    }
+}
+
+TEST_CASE("IsLegal_Chess960CastlingRookHidesAttack_ReturnsFalse")
+{
+    Board board("1k6/8/8/8/8/8/8/rR1K4 w B - 0 1");
+    Move move = NewMove(kD1, kC1, kWhiteKing, kNoPiece, kNoPiece, kQueenSideCastle);
+
+    REQUIRE(IsPseudoLegal(board, move));
+    REQUIRE(!IsLegal(board, move));
+}
@@ -0,0 +1,115 @@
+/// @file PerftCheckpoint_tests.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include <filesystem>
+
+#include "catch2/catch_all.hpp"
+
+#include "m8chess/Board.hpp"
+#include "m8chess/Perft.hpp"
+#include "m8chess/PerftCheckpoint.hpp"
+
+using namespace m8;
+
+namespace
+{
+    const transposition::ZobristKey kKey = 0x0123456789ABCDEF;
+    const int kDepth = 5;
+
+    const PerftCheckpoint::Path kFirstPath = { NewMove(kE2, kE4, kWhitePawn) };
+    const PerftCheckpoint::Path kSecondPath = { NewMove(kD2, kD4, kWhitePawn), NewMove(kD7, kD5, kBlackPawn) };
+
+    /// Returns the name of an empty checkpoint file in the temporary directory.
+    std::string NewCheckpointFile()
+    {
+        auto filename = std::filesystem::temp_directory_path() / "m8-perft-checkpoint-tests.ckpt";
+        std::filesystem::remove(filename);
+        return filename.string();
+    }
+
+    /// Write a checkpoint file with two records.
+    void WriteCheckpoint(const std::string& filename)
+    {
+        PerftCheckpoint checkpoint(filename, kKey, kDepth);
+        checkpoint.Record(kFirstPath, 20);
+        checkpoint.Record(kSecondPath, 400);
+    }
+}
+
+TEST_CASE("PerftCheckpoint restores the records of a previous run")
+{
+    auto filename = NewCheckpointFile();
+    WriteCheckpoint(filename);
+
+    PerftCheckpoint checkpoint(filename, kKey, kDepth);
+    std::uint64_t count;
+
+    REQUIRE(checkpoint.restored() == 2);
+    REQUIRE(checkpoint.TryGet(kFirstPath, count));
+    REQUIRE(count == 20);
+    REQUIRE(checkpoint.TryGet(kSecondPath, count));
+    REQUIRE(count == 400);
+    REQUIRE_FALSE(checkpoint.TryGet({ NewMove(kG1, kF3, kWhiteKnight) }, count));
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("PerftCheckpoint ignores a truncated last record")
+{
+    auto filename = NewCheckpointFile();
+    WriteCheckpoint(filename);
+    auto size = std::filesystem::file_size(filename);
+    std::filesystem::resize_file(filename, size - 3);
+
+    std::uint64_t count;
+    {
+        PerftCheckpoint checkpoint(filename, kKey, kDepth);
+
+        REQUIRE(checkpoint.restored() == 1);
+        REQUIRE(checkpoint.TryGet(kFirstPath, count));
+        REQUIRE(count == 20);
+        REQUIRE_FALSE(checkpoint.TryGet(kSecondPath, count));
+
+        // The subtree counted again is appended after the valid records.
+        checkpoint.Record(kSecondPath, 400);
+    }
+
+    PerftCheckpoint checkpoint(filename, kKey, kDepth);
+
+    REQUIRE(checkpoint.restored() == 2);
+    REQUIRE(checkpoint.TryGet(kSecondPath, count));
+    REQUIRE(count == 400);
+    REQUIRE(std::filesystem::file_size(filename) == size);
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("PerftCheckpoint rejects a file created for another test")
+{
+    auto filename = NewCheckpointFile();
+    WriteCheckpoint(filename);
+
+    SECTION("Other position") { REQUIRE_THROWS_AS(PerftCheckpoint(filename, kKey + 1, kDepth), PerftCheckpointError); }
+    SECTION("Other depth") { REQUIRE_THROWS_AS(PerftCheckpoint(filename, kKey, kDepth + 1), PerftCheckpointError); }
+
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("Perft resumed from a truncated checkpoint gives the right count")
+{
+    auto filename = NewCheckpointFile();
+    Board board(kStartingPositionFEN);
+    {
+        PerftCountObserver observer;
+        Perft perft(4, board, &observer, filename);
+        perft.Run();
+    }
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 5);
+
+    PerftCountObserver observer;
+    Perft perft(4, board, &observer, filename);
+    perft.Run();
+
+    REQUIRE(observer.count() == 197281);
+    std::filesystem::remove(filename);
+}
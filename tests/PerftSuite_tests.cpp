@@ -0,0 +1,40 @@
+/// @file PerftSuite_tests.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include "catch2/catch_all.hpp"
+
+#include "m8chess/PerftSuite.hpp"
+
+using namespace m8;
+
+TEST_CASE("ParseEpdLine reads the fen and the expected counts")
+{
+    auto position = PerftSuite::ParseEpdLine("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1 ;D1 14 ;D2 191 ;D3 2812");
+
+    REQUIRE(position.fen == "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1");
+    REQUIRE(position.expected.size() == 3);
+    REQUIRE(position.expected[0] == std::make_pair(1, UINT64_C(14)));
+    REQUIRE(position.expected[1] == std::make_pair(2, UINT64_C(191)));
+    REQUIRE(position.expected[2] == std::make_pair(3, UINT64_C(2812)));
+}
+
+TEST_CASE("ParseEpdLine throws on an invalid operation")
+{
+    REQUIRE_THROWS_AS(PerftSuite::ParseEpdLine("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1 ;X1 14"), PerftSuiteError);
+    REQUIRE_THROWS_AS(PerftSuite::ParseEpdLine("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1 ;D1"), PerftSuiteError);
+}
+
+TEST_CASE("ParseEpdLine throws on an invalid depth")
+{
+    REQUIRE_THROWS_AS(PerftSuite::ParseEpdLine("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1 ;Dx 20"), PerftSuiteError);
+    REQUIRE_THROWS_AS(PerftSuite::ParseEpdLine("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1 ;D1x 20"), PerftSuiteError);
+    REQUIRE_THROWS_AS(PerftSuite::ParseEpdLine("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1 ;D99999999999 20"), PerftSuiteError);
+}
+
+TEST_CASE("ParseEpdLine throws on a depth below 1")
+{
+    REQUIRE_THROWS_AS(PerftSuite::ParseEpdLine("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1 ;D0 1"), PerftSuiteError);
+    REQUIRE_THROWS_AS(PerftSuite::ParseEpdLine("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1 ;D-1 1"), PerftSuiteError);
+}
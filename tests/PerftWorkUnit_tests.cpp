@@ -0,0 +1,81 @@
+/// @file PerftWorkUnit_tests.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include <filesystem>
+#include <fstream>
+
+#include "catch2/catch_all.hpp"
+
+#include "m8chess/PerftWorkUnit.hpp"
+
+using namespace m8;
+
+namespace
+{
+    /// Split a perft test of the starting position in a temporary directory and run
+    /// all the work units.
+    std::filesystem::path RunWorkUnits(int depth, std::size_t count)
+    {
+        auto directory = std::filesystem::temp_directory_path() / "m8-perft-work-unit-tests";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        auto units = PerftWorkUnit::Split(Board(kStartingPositionFEN), depth, count);
+        for (std::size_t i = 0; i < units.size(); ++i)
+        {
+            auto filename = directory / ("unit" + std::to_string(i) + ".unit");
+            units[i].Write(filename.string());
+
+            auto unit = PerftWorkUnit::Read(filename.string());
+            unit.WriteResult(std::filesystem::path(filename).replace_extension(".result").string(), unit.Run(), 0);
+        }
+
+        return directory;
+    }
+
+    void AppendToResult(const std::filesystem::path& directory, const std::string& text)
+    {
+        std::ofstream out(directory / "unit0.result", std::ios::app);
+        out << text;
+    }
+}
+
+TEST_CASE("Split then Merge gives the perft count of the position")
+{
+    auto count = GENERATE(std::size_t(1), std::size_t(7), std::size_t(50));
+    auto directory = RunWorkUnits(3, count);
+    PerftCountObserver observer;
+
+    PerftWorkUnit::Merge(directory.string(), observer);
+
+    REQUIRE(observer.count() == 8902);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Merge skips the blank lines of the results")
+{
+    auto directory = RunWorkUnits(3, 4);
+    AppendToResult(directory, "\n   \n");
+    PerftCountObserver observer;
+
+    PerftWorkUnit::Merge(directory.string(), observer);
+
+    REQUIRE(observer.count() == 8902);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Merge throws on a truncated line in the results")
+{
+    auto directory = RunWorkUnits(3, 4);
+    PerftCountObserver observer;
+
+    SECTION("Count without path") { AppendToResult(directory, "count 20\n"); }
+    SECTION("Count without value") { AppendToResult(directory, "count\n"); }
+    SECTION("Time without value") { AppendToResult(directory, "time\n"); }
+    SECTION("Truncated keyword") { AppendToResult(directory, "cou\n"); }
+
+    REQUIRE_THROWS_AS(PerftWorkUnit::Merge(directory.string(), observer), PerftWorkUnitError);
+    std::filesystem::remove_all(directory);
+}
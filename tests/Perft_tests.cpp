@@ -111,4 +111,32 @@ TEST_CASE("Perft test of differents positions at different depth")
     perft.Run();
 
     REQUIRE(expected == observer.count());
+}
+
+TEST_CASE("Perft gives the same counts with and without the hash table")
+{
+    const std::string kKiwipetePosition("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -");
+
+    std::string fen;
+    int depth;
+
+    SECTION("Starting position, depth 4") { fen = kStartingPositionFEN; depth = 4; }
+    SECTION("Kiwipete position, depth 3") { fen = kKiwipetePosition; depth = 3; }
+
+    auto threads = GENERATE(1, 4);
+
+    Board board(fen);
+    PerftHashTable no_hash_table(0);
+    PerftHashTable hash_table(1024 * 1024);
+    TestPerftObserver no_hash_observer;
+    TestPerftObserver hash_observer;
+
+    Perft no_hash_perft(depth, board, &no_hash_observer, no_hash_table, threads);
+    no_hash_perft.Run();
+    Perft hash_perft(depth, board, &hash_observer, hash_table, threads);
+    hash_perft.Run();
+
+    REQUIRE_FALSE(no_hash_table.enabled());
+    REQUIRE(hash_table.enabled());
+    REQUIRE(no_hash_observer.count() == hash_observer.count());
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+/// @file   See_tests.cpp
+/// @author Mathieu Pagé
+/// @date   October 2026
+/// @brief  Contains tests of the static exchange evaluation.
+
+#include "catch2/catch_all.hpp"
+
+#include "m8chess/movegen/See.hpp"
+
+#include "m8chess/Board.hpp"
+#include "m8chess/Move.hpp"
+
+using namespace m8;
+using namespace m8::movegen;
+
+TEST_CASE("See__undefended_piece__win_the_piece")
+{
+    Board board("4k3/8/8/3r4/8/8/8/3RK3 w - -");
+    Move move = NewMove(kD1, kD5, kWhiteRook, kBlackRook);
+
+    REQUIRE(See(board, move) == kSeeValues[kRook]);
+}
+
+TEST_CASE("See__queen_takes_pawn_defended_by_pawn__lose_the_queen")
+{
+    Board board("4k3/8/2p5/3p4/8/8/3Q4/4K3 w - -");
+    Move move = NewMove(kD2, kD5, kWhiteQueen, kBlackPawn);
+
+    REQUIRE(See(board, move) == kSeeValues[kPawn] - kSeeValues[kQueen]);
+}
+
+TEST_CASE("See__xray_attacker__win_the_rook")
+{
+    // The black rook on d5 is defended by the rook on d8. The white rook on d2 is
+    // backed by the queen on d1 through an x-ray.
+    Board board("3r2k1/8/8/3r4/8/8/3R4/3QK3 w - -");
+    Move move = NewMove(kD2, kD5, kWhiteRook, kBlackRook);
+
+    REQUIRE(See(board, move) == kSeeValues[kRook]);
+}
+
+TEST_CASE("See__xray_defender__capture_is_losing")
+{
+    // The knight on d5 is attacked by two rooks and defended by two rooks, the one on
+    // d8 through an x-ray.
+    Board board("3r2k1/3r4/8/3n4/8/8/3R4/3RK3 w - -");
+    Move move = NewMove(kD2, kD5, kWhiteRook, kBlackKnight);
+
+    REQUIRE(See(board, move) == kSeeValues[kKnight] - kSeeValues[kRook]);
+}
+
+TEST_CASE("See__en_passant__win_the_pawn")
+{
+    Board board("4k3/8/8/3pP3/8/8/8/4K3 w - d6");
+    Move move = NewMove(kE5, kD6, kWhitePawn, kBlackPawn);
+
+    REQUIRE(See(board, move) == kSeeValues[kPawn]);
+}
@@ -0,0 +1,42 @@
+/// @file Statistics_tests.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include "catch2/catch_all.hpp"
+
+#include "m8common/Statistics.hpp"
+
+using namespace m8;
+using Catch::Approx;
+
+TEST_CASE("TrimExtremes removes the smallest and largest values")
+{
+    auto trimmed = TrimExtremes({ 5, 1, 3, 9, 4 });
+
+    REQUIRE(trimmed == std::vector<double>({ 3, 4, 5 }));
+}
+
+TEST_CASE("TrimExtremes keeps small samples")
+{
+    REQUIRE(TrimExtremes({ 5, 1 }) == std::vector<double>({ 5, 1 }));
+}
+
+TEST_CASE("ComputeStatistics computes the mean, standard deviation and confidence interval")
+{
+    auto stats = ComputeStatistics({ 2, 4, 4, 4, 5, 5, 7, 9 });
+
+    REQUIRE(stats.size == 8);
+    REQUIRE(stats.mean == Approx(5));
+    REQUIRE(stats.std_dev == Approx(2.13809).epsilon(1e-5));
+    REQUIRE(stats.ci95 == Approx(1.78749).epsilon(1e-4));
+}
+
+TEST_CASE("WelchTTest detects different means")
+{
+    auto lhs = ComputeStatistics({ 100, 101, 99, 100, 102, 98 });
+    auto rhs = ComputeStatistics({ 110, 111, 109, 110, 112, 108 });
+
+    REQUIRE(WelchTTest(lhs, rhs) < 0.001);
+    REQUIRE(WelchTTest(lhs, lhs) == Approx(1));
+}
@@ -7,6 +7,7 @@
 
 #include "m8chess/eval/Eval.hpp"
 
+#include "m8chess/transposition/Bucket.hpp"
 #include "m8chess/transposition/TranspositionEntry.hpp"
 
 using namespace m8;
@@ -15,37 +16,112 @@ using namespace m8::transposition;
 
 TEST_CASE("TranspositionEntry_StoreData_RetrieveCorrectData")
 {
-    ZobristKey key          = UINT64_C(0xeadd8e089d843fc3);
+    Board board(kStartingPositionFEN);
     Move move               = NewMove(kE2, kE4, kWhitePawn);
-    std::uint8_t generation = 222;
+    std::uint8_t generation = 42;
     EntryType type          = EntryType::Exact;
     DepthType depth         = 20;
     DepthType distance      = 3;
     EvalType eval           = 100;
 
     SECTION ("Min generation")  { generation = 0; }
-    SECTION ("Max generation")  { generation = 255; }
+    SECTION ("Max generation")  { generation = 63; }
     SECTION ("Type Exact")      { type = EntryType::Exact; }
     SECTION ("Type LowerBound") { type = EntryType::LowerBound; }
     SECTION ("Type UpperBound") { type = EntryType::UpperBound; }
     SECTION ("Min depth")       { depth = 0; }
-    SECTION ("Max depth")       { depth = 4095; }
+    SECTION ("Max depth")       { depth = 255; }
     SECTION ("Min eval")        { eval = -kEvalMat; }
     SECTION ("Max eval")        { eval = +kEvalMat; }
 
-    TranspositionEntry sut(key, move, generation, type, depth, distance, eval);
+    TranspositionEntry sut(move, generation, type, depth, distance, eval);
 
-    auto actual_key        = sut.key();
-    auto actual_move       = sut.move();
+    auto actual_move       = sut.GetMove(board);
     auto actual_generation = sut.generation();
     auto actual_type       = sut.type();
     auto actual_depth      = sut.depth();
     auto actual_eval       = sut.GetEval(distance);
 
-    REQUIRE(key == actual_key);
     REQUIRE(move == actual_move);
     REQUIRE(generation == actual_generation);
     REQUIRE(type == actual_type);
     REQUIRE(depth == actual_depth);
     REQUIRE(eval == actual_eval);
-}
\ No newline at end of file
+}
+
+TEST_CASE("TranspositionEntry_DepthTooDeep_StoreMaxDepth")
+{
+    TranspositionEntry sut(kNullMove, 0, EntryType::Exact, 300, 0, 0);
+
+    REQUIRE(255 == sut.depth());
+}
+
+TEST_CASE("Bucket_InsertEntries_FindAllEntries")
+{
+    Bucket sut{};
+    ZobristKey key = UINT64_C(0xeadd8e089d843fc3);
+
+    for (DepthType i = 0; i < 8; ++i)
+    {
+        sut.Insert(key + i, kNullMove, 1, EntryType::Exact, i, 0, 100 + i);
+    }
+
+    for (DepthType i = 0; i < 8; ++i)
+    {
+        auto entry = sut[key + i];
+        REQUIRE(entry.has_value());
+        REQUIRE(i == entry->depth());
+        REQUIRE(100 + i == entry->GetEval(0));
+    }
+    REQUIRE_FALSE(sut[key + 8].has_value());
+}
+
+TEST_CASE("Bucket_InsertSamePosition_ReplaceEntry")
+{
+    Bucket sut{};
+    ZobristKey key = UINT64_C(0xeadd8e089d843fc3);
+
+    sut.Insert(key, kNullMove, 1, EntryType::LowerBound, 10, 0, 50);
+    sut.Insert(key, kNullMove, 1, EntryType::Exact, 2, 0, 25);
+
+    auto entry = sut[key];
+    REQUIRE(entry.has_value());
+    REQUIRE(EntryType::Exact == entry->type());
+    REQUIRE(2 == entry->depth());
+    REQUIRE(25 == entry->GetEval(0));
+}
+
+TEST_CASE("Bucket_BucketFull_ReplaceOldestShallowestEntry")
+{
+    Bucket sut{};
+    ZobristKey key = UINT64_C(0xeadd8e089d843fc3);
+
+    // The entry 5 is the oldest and the entry 3 is the shallowest.
+    sut.Insert(key + 5, kNullMove, 1, EntryType::Exact, 15, 0, 0);
+    for (DepthType i = 0; i < 8; ++i)
+    {
+        if (i != 5)
+        {
+            sut.Insert(key + i, kNullMove, 2, EntryType::Exact, i == 3 ? 1 : 10 + i, 0, 0);
+        }
+    }
+
+    SECTION("Current generation is newer")
+    {
+        sut.Insert(key + 8, kNullMove, 2, EntryType::Exact, 20, 0, 0);
+
+        REQUIRE_FALSE(sut[key + 5].has_value());
+        REQUIRE(sut[key + 3].has_value());
+    }
+
+    SECTION("All entries have the same age")
+    {
+        sut.Insert(key + 5, kNullMove, 2, EntryType::Exact, 15, 0, 0);
+        sut.Insert(key + 8, kNullMove, 2, EntryType::Exact, 20, 0, 0);
+
+        REQUIRE_FALSE(sut[key + 3].has_value());
+        REQUIRE(sut[key + 5].has_value());
+    }
+
+    REQUIRE(sut[key + 8].has_value());
+}
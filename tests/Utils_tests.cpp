@@ -16,4 +16,12 @@ TEST_CASE("CalculateMask_Pos2Size3_CorrecMaskedReturned")
     std::uint64_t actual = m8::CalculateMask(position, size);
 
     REQUIRE(expected == actual);
-}
\ No newline at end of file
+}
+
+TEST_CASE("MulHi64 returns the high part of the product")
+{
+    REQUIRE(m8::MulHi64(UINT64_C(0xFFFFFFFFFFFFFFFF), 768) == 767);
+    REQUIRE(m8::MulHi64(UINT64_C(0x8000000000000000), 768) == 384);
+    REQUIRE(m8::MulHi64(0, 768) == 0);
+    REQUIRE(m8::MulHi64(UINT64_C(0x0000000100000000), UINT64_C(0x0000000100000000)) == 1);
+}
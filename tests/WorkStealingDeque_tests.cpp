@@ -0,0 +1,141 @@
+/// @file WorkStealingDeque_tests.cpp
+/// @author Mathieu Pagé (m@mathieupage.com)
+/// @copyright Copyright (c) 2026 Mathieu Pagé
+/// @date October 2026
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_all.hpp"
+
+#include "m8common/WorkStealingDeque.hpp"
+
+using namespace m8;
+
+TEST_CASE("WorkStealingDeque is empty when created")
+{
+    WorkStealingDeque<int, 4> deque;
+
+    REQUIRE(deque.Pop() == nullptr);
+    REQUIRE(deque.Steal() == nullptr);
+}
+
+TEST_CASE("WorkStealingDeque pops the last item pushed")
+{
+    std::array<int, 3> items = { 1, 2, 3 };
+    WorkStealingDeque<int, 4> deque;
+    for (auto& item : items)
+    {
+        REQUIRE(deque.Push(&item));
+    }
+
+    REQUIRE(deque.Pop() == &items[2]);
+    REQUIRE(deque.Pop() == &items[1]);
+    REQUIRE(deque.Pop() == &items[0]);
+    REQUIRE(deque.Pop() == nullptr);
+}
+
+TEST_CASE("WorkStealingDeque steals the first item pushed")
+{
+    std::array<int, 3> items = { 1, 2, 3 };
+    WorkStealingDeque<int, 4> deque;
+    for (auto& item : items)
+    {
+        REQUIRE(deque.Push(&item));
+    }
+
+    REQUIRE(deque.Steal() == &items[0]);
+    REQUIRE(deque.Steal() == &items[1]);
+    REQUIRE(deque.Steal() == &items[2]);
+    REQUIRE(deque.Steal() == nullptr);
+}
+
+TEST_CASE("WorkStealingDeque pops and steals from opposite ends")
+{
+    std::array<int, 4> items = { 1, 2, 3, 4 };
+    WorkStealingDeque<int, 4> deque;
+    for (auto& item : items)
+    {
+        REQUIRE(deque.Push(&item));
+    }
+
+    REQUIRE(deque.Steal() == &items[0]);
+    REQUIRE(deque.Pop() == &items[3]);
+    REQUIRE(deque.Steal() == &items[1]);
+    REQUIRE(deque.Pop() == &items[2]);
+    REQUIRE(deque.Pop() == nullptr);
+    REQUIRE(deque.Steal() == nullptr);
+}
+
+TEST_CASE("WorkStealingDeque refuses items when full")
+{
+    std::array<int, 3> items = { 1, 2, 3 };
+    WorkStealingDeque<int, 2> deque;
+
+    REQUIRE(deque.Push(&items[0]));
+    REQUIRE(deque.Push(&items[1]));
+    REQUIRE_FALSE(deque.Push(&items[2]));
+
+    // The space freed by a steal can be reused.
+    REQUIRE(deque.Steal() == &items[0]);
+    REQUIRE(deque.Push(&items[2]));
+    REQUIRE(deque.Pop() == &items[2]);
+    REQUIRE(deque.Pop() == &items[1]);
+}
+
+TEST_CASE("WorkStealingDeque gives each item to a single thread")
+{
+    const int kItemsCount = 100000;
+    const int kThievesCount = 3;
+
+    std::vector<int> items(kItemsCount);
+    std::vector<std::atomic<int>> taken(kItemsCount);
+    WorkStealingDeque<int, 64> deque;
+    std::atomic<bool> done = false;
+
+    auto take = [&](int* item) { taken[item - items.data()].fetch_add(1, std::memory_order_relaxed); };
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < kThievesCount; ++i)
+    {
+        thieves.emplace_back([&]()
+        {
+            while (!done.load(std::memory_order_acquire))
+            {
+                if (auto item = deque.Steal())
+                {
+                    take(item);
+                }
+            }
+        });
+    }
+
+    for (auto& item : items)
+    {
+        while (!deque.Push(&item))
+        {
+            if (auto popped = deque.Pop())
+            {
+                take(popped);
+            }
+        }
+    }
+
+    while (auto item = deque.Pop())
+    {
+        take(item);
+    }
+
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves)
+    {
+        thief.join();
+    }
+
+    for (auto& count : taken)
+    {
+        REQUIRE(count == 1);
+    }
+}